@@ -19,8 +19,11 @@
 #define BWIDGETS_BDEVICES_HPP_
 
 #include <set>
-#include <list>
+#include <map>
+#include <vector>
+#include <array>
 #include <chrono>
+#include <cstdint>
 #include <algorithm>
 #include "../BUtilities/Point.hpp"
 
@@ -60,6 +63,55 @@ enum KeyCode {
 	KEY_SUPER
 };
 
+class MouseDevice
+{
+public:
+	/**
+	 * Enumeration of mouse buttons as input device for event handling
+	 */
+	enum ButtonCode
+	{
+		NO_BUTTON	= 0,
+		LEFT_BUTTON	= 1,
+		MIDDLE_BUTTON	= 2,
+		RIGHT_BUTTON	= 3,
+		NR_OF_BUTTONS	= 4
+	};
+
+	ButtonCode button;
+	BUtilities::Point<> position;
+
+protected:
+	std::chrono::steady_clock::time_point time_;
+
+public:
+	MouseDevice () : MouseDevice (NO_BUTTON, BUtilities::Point<> ()) {}
+	MouseDevice (const ButtonCode but) : MouseDevice (but, BUtilities::Point<> ()) {}
+	MouseDevice (const ButtonCode but, const BUtilities::Point<>& pos) :
+			button (but), position (pos),
+			time_ (std::chrono::steady_clock::now()) {}
+
+	std::chrono::steady_clock::time_point getTime () const {return time_;}
+
+	friend inline bool operator< (const MouseDevice& lhs, const MouseDevice& rhs)
+	{
+		if( lhs.button < rhs.button ) return true;
+		return false;
+	}
+
+	friend inline bool operator== (const MouseDevice& lhs, const MouseDevice& rhs)
+	{
+		if( lhs.button == rhs.button ) return true;
+		return false;
+	}
+
+	friend inline bool operator> (const MouseDevice& lhs, const MouseDevice& rhs) {return rhs < lhs;}
+	friend inline bool operator<=(const MouseDevice& lhs, const MouseDevice& rhs) {return !(lhs > rhs);}
+	friend inline bool operator>=(const MouseDevice& lhs, const MouseDevice& rhs) {return !(lhs < rhs);}
+	friend inline bool operator!=(const MouseDevice& lhs, const MouseDevice& rhs) {return !(lhs==rhs);}
+};
+
+
 /**
  * Class BDevices::DeviceGrab<T>
  *
@@ -86,9 +138,9 @@ public:
 	BWidgets::Widget* getWidget () const {return widget_;}
 
 	/* Gets the devices of this DeviceGrab
-	 * @return	std::set<T> of devices
+	 * @return	Reference to the std::set<T> of devices
 	 */
-	std::set<T> getDevices () const {return devices_;}
+	const std::set<T>& getDevices () const {return devices_;}
 
 	/* Gets infomation whether this DeviceGrab contains a given device or
 	 * not.
@@ -104,39 +156,110 @@ public:
 
 };
 
-template<typename T> class DeviceGrabStack : std::list<DeviceGrab<T>>
+/**
+ * Class BDevices::DeviceSlots<T, Slot>
+ *
+ * Maps devices to slots. Default: std::map. Specialized for MouseDevice
+ * (fixed array for the mouse buttons).
+ */
+template<typename T, typename Slot> class DeviceSlots
 {
 protected:
-	std::list<DeviceGrab<T>> stack_;
+	std::map<T, Slot> slots_;
 
-	bool contains (BWidgets::Widget* widget)
+public:
+	Slot* find (const T& device)
 	{
-		for (typename std::list<DeviceGrab<T>>::iterator it = stack_.begin(); it != stack_.end(); ++it)
-		{
-			DeviceGrab<T>& dg = *it;
-			if (dg.getWidget() == widget) return true;
-		}
-		return false;
+		typename std::map<T, Slot>::iterator it = slots_.find (device);
+		return (it != slots_.end() ? &it->second : nullptr);
+	}
+
+	Slot& get (const T& device) {return slots_[device];}
+
+	template<typename F> void forEach (F func)
+	{
+		for (typename std::map<T, Slot>::reference s : slots_) func (s.second);
 	}
 
-	std::set<T> getDevices (BWidgets::Widget* widget)
+	void clear () {slots_.clear();}
+};
+
+template<typename Slot> class DeviceSlots<MouseDevice, Slot>
+{
+protected:
+	std::array<Slot, MouseDevice::NR_OF_BUTTONS> buttons_;
+	std::map<int, Slot> extraButtons_;
+
+public:
+	Slot* find (const MouseDevice& device)
 	{
-		std::set<T> devices {};
-		for (typename std::list<DeviceGrab<T>>::iterator it = stack_.begin(); it != stack_.end(); ++it)
-		{
-			DeviceGrab<T>& dg = *it;
-			if (dg.getWidget() == widget)
-			{
-				std::set<T> d = dg.getDevices ();
-				devices.insert (d.begin(), d.end());
-			}
-		}
+		if ((device.button >= 0) && (device.button < MouseDevice::NR_OF_BUTTONS)) return &buttons_[device.button];
+		typename std::map<int, Slot>::iterator it = extraButtons_.find (device.button);
+		return (it != extraButtons_.end() ? &it->second : nullptr);
+	}
+
+	Slot& get (const MouseDevice& device)
+	{
+		if ((device.button >= 0) && (device.button < MouseDevice::NR_OF_BUTTONS)) return buttons_[device.button];
+		return extraButtons_[device.button];
+	}
+
+	template<typename F> void forEach (F func)
+	{
+		for (Slot& s : buttons_) func (s);
+		for (typename std::map<int, Slot>::reference s : extraButtons_) func (s.second);
+	}
 
-		return devices;
+	void clear ()
+	{
+		for (Slot& s : buttons_) s.clear();
+		extraButtons_.clear();
+	}
+};
+
+/**
+ * Class BDevices::DeviceGrabStack<T>
+ *
+ * Stack of DeviceGrabs. Each device has its own slot containing the
+ * DeviceGrabs (one device each) in the order of their addition. DeviceGrabs
+ * without devices (joker, all devices) are stored in a separate slot. The
+ * topmost DeviceGrab for a device is found by comparing the tops of the
+ * device slot and of the joker slot. Thus, add, remove, and lookup of a
+ * single device don't depend on the number of grabs.
+ */
+template<typename T> class DeviceGrabStack
+{
+protected:
+	struct Entry
+	{
+		DeviceGrab<T> grab;
+		uint64_t order;
+	};
+
+	typedef std::vector<Entry> Slot;
+
+	DeviceSlots<T, Slot> slots_;
+	Slot jokers_;
+	uint64_t order_ = 0;
+
+	static void erase (Slot& slot, BWidgets::Widget* widget)
+	{
+		if (!widget) slot.clear();
+		else slot.erase
+		(
+			std::remove_if (slot.begin(), slot.end(), [widget] (const Entry& e) {return e.grab.getWidget() == widget;}),
+			slot.end()
+		);
 	}
 
 public:
-	using std::list<DeviceGrab<T>>::clear;
+	/* Removes all DeviceGrabs from the stack.
+	 */
+	void clear ()
+	{
+		slots_.clear();
+		jokers_.clear();
+	}
 
 	/* Removes DeviceGrab devices from the stack. If the DeviceGrab devices
 	 * are completely depleted, the empty DeviceGrab is removed from the
@@ -152,152 +275,86 @@ public:
 	 *			removed.
 	 */
 	void remove (BWidgets::Widget* widget) {remove (DeviceGrab<T> (widget));}
-	void remove (const T& device) {remove (DeviceGrab<T> (nullptr, device));}
+	void remove (const T& device)
+	{
+		Slot* slot = slots_.find (device);
+		if (slot) slot->clear();
+	}
 	void remove (const std::set<T>& devices) {remove (DeviceGrab<T> (nullptr, devices));}
 	void remove (const DeviceGrab<T>& deviceGrab)
 	{
-		bool done = true;
-		std::set<T> devices = deviceGrab.getDevices();
 		BWidgets::Widget* widget = deviceGrab.getWidget();
+		const std::set<T>& devices = deviceGrab.getDevices();
 
-		do
+		// Joker (std::set<T>{}): Remove all devices
+		if (devices.empty())
 		{
-			done = true;
+			slots_.forEach ([widget] (Slot& s) {erase (s, widget);});
+			erase (jokers_, widget);
+		}
 
-			for (typename std::list<DeviceGrab<T>>::iterator it = stack_.begin(); it != stack_.end(); ++it)
+		// Deletion of individual devices is not allowed for jokers
+		else
+		{
+			for (const T& d : devices)
 			{
-				DeviceGrab<T>& dg = *it;
-				if ((!widget) || (dg.getWidget() == widget))
-				{
-					// Erase list item if joker (std::set<T>{}) used
-					if (devices.empty())
-					{
-						stack_.erase (it);
-						done = false;
-						break;
-					}
-
-					std::set<T> stackDevices = dg.getDevices();
-
-					// Deletion of individual devices is not allowed
-					// if joker (std::set<T>{}) is set
-					if (stackDevices.empty()) {}
-
-					else
-					{
-						// Build difference
-						std::set<T> diff = {};
-						std::set_difference
-						(
-							stackDevices.begin(), stackDevices.end(),
-							devices.begin(), devices.end(),
-							std::inserter (diff, diff.begin())
-						);
-
-						// Erase list item if all devices are deleted
-						if (diff.empty())
-						{
-							stack_.erase (it);
-							done = false;
-							break;
-						}
-
-						// Otherwise replace list item
-						else dg = DeviceGrab<T> (dg.getWidget(), diff);
-					}
-				}
+				Slot* slot = slots_.find (d);
+				if (slot) erase (*slot, widget);
 			}
-		} while (!done);
+		}
 	}
 
 	/* Adds a widget to the top of DeviceGrab stack. If the widget is
-	 * already inside the stack, it is moved to the top and the linked
-	 * devices are combined.
+	 * already inside the stack for a device, it is moved to the top. A 
+	 * widget with a joker DeviceGrab keeps the joker. 
 	 * @param deviceGrab	DeviceGrab
 	 */
 	void add (BWidgets::Widget* widget) {add (DeviceGrab<T> (widget, std::set<T>{}));}
 	void add (const DeviceGrab<T>& deviceGrab)
 	{
 		BWidgets::Widget* widget = deviceGrab.getWidget();
-		std::set<T> devices = deviceGrab.getDevices ();
+		const std::set<T>& devices = deviceGrab.getDevices ();
+		++order_;
 
-		if (contains(widget))
+		// Joker or joker already set: replaces all DeviceGrabs of widget
+		typename Slot::iterator it = std::find_if (jokers_.begin(), jokers_.end(), [widget] (const Entry& e) {return e.grab.getWidget() == widget;});
+		if (devices.empty() || (it != jokers_.end()))
 		{
-			std::set<T> d2 = getDevices (widget);
-			if (devices.empty() || d2.empty()) devices.clear();
-			else devices.insert (d2.begin(), d2.end());
-			remove (deviceGrab.getWidget());
+			if (devices.empty()) slots_.forEach ([widget] (Slot& s) {erase (s, widget);});
+			if (it != jokers_.end()) jokers_.erase (it);
+			jokers_.push_back (Entry {DeviceGrab<T> (widget), order_});
+			return;
 		}
 
-		stack_.push_back (DeviceGrab<T> (widget, devices));
+		for (const T& d : devices)
+		{
+			Slot& slot = slots_.get (d);
+			erase (slot, widget);
+			if (devices.size() == 1) slot.push_back (Entry {deviceGrab, order_});
+			else slot.push_back (Entry {DeviceGrab<T> (widget, d), order_});
+		}
 	}
 
 	/* Gets (the pointer to) the DeviceGrab containing the respective
 	 * device. Starts from the top of the DeviceGrab stack.
 	 * @param device	<T> of the respective device.
 	 * @return		Pointer to the respective DeviceGrab or nullptr.
+	 *			Invalidated by the next add or remove.
 	 */
 	DeviceGrab<T>* getGrab (const T& device)
 	{
-		for (typename std::list<DeviceGrab<T>>::reverse_iterator rit = stack_.rbegin (); rit != stack_.rend (); ++rit)
-		{
-			DeviceGrab<T>& dg = *rit;
-			if (dg.contains (device)) return &dg;
-		}
+		Slot* slot = slots_.find (device);
+		Entry* e1 = ((slot && (!slot->empty())) ? &slot->back() : nullptr);
+		Entry* e2 = (jokers_.empty() ? nullptr : &jokers_.back());
 
+		if (e1 && e2) return (e1->order > e2->order ? &e1->grab : &e2->grab);
+		if (e1) return &e1->grab;
+		if (e2) return &e2->grab;
 		return nullptr;
 	}
 
 };
 
-class MouseDevice
-{
-public:
-	/**
-	 * Enumeration of mouse buttons as input device for event handling
-	 */
-	enum ButtonCode
-	{
-		NO_BUTTON	= 0,
-		LEFT_BUTTON	= 1,
-		MIDDLE_BUTTON	= 2,
-		RIGHT_BUTTON	= 3,
-		NR_OF_BUTTONS	= 4
-	};
-
-	ButtonCode button;
-	BUtilities::Point<> position;
-
-protected:
-	std::chrono::steady_clock::time_point time_;
-
-public:
-	MouseDevice () : MouseDevice (NO_BUTTON, BUtilities::Point<> ()) {}
-	MouseDevice (const ButtonCode but) : MouseDevice (but, BUtilities::Point<> ()) {}
-	MouseDevice (const ButtonCode but, const BUtilities::Point<>& pos) :
-			button (but), position (pos),
-			time_ (std::chrono::steady_clock::now()) {}
-
-	std::chrono::steady_clock::time_point getTime () const {return time_;}
-
-	friend inline bool operator< (const MouseDevice& lhs, const MouseDevice& rhs)
-	{
-		if( lhs.button < rhs.button ) return true;
-		return false;
-	}
-
-	friend inline bool operator== (const MouseDevice& lhs, const MouseDevice& rhs)
-	{
-		if( lhs.button == rhs.button ) return true;
-		return false;
-	}
-
-	friend inline bool operator> (const MouseDevice& lhs, const MouseDevice& rhs) {return rhs < lhs;}
-	friend inline bool operator<=(const MouseDevice& lhs, const MouseDevice& rhs) {return !(lhs > rhs);}
-	friend inline bool operator>=(const MouseDevice& lhs, const MouseDevice& rhs) {return !(lhs < rhs);}
-	friend inline bool operator!=(const MouseDevice& lhs, const MouseDevice& rhs) {return !(lhs==rhs);}
-};
-
 
 }
 
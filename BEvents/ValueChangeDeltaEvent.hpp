@@ -0,0 +1,100 @@
+/* ValueChangeDeltaEvent.hpp
+ * Copyright (C) 2018 - 2022  Sven Jähnichen
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef BEVENTS_VALUECHANGEDELTAEVENT_HPP_
+#define BEVENTS_VALUECHANGEDELTAEVENT_HPP_
+
+#include "Event.hpp"
+#include "ValueChangeTypedEvent.hpp"
+#include <memory>
+#include <vector>
+
+namespace BEvents
+{
+
+/**
+ *  @brief  Event to communicate changed parts of the value of
+ *  ValueWidgets.
+ *  @tparam T  Type of a single change.
+ *  @tparam V  Value type.
+ *
+ *  Specialization of ValueChangeTypedEvent for widgets with composite
+ *  values (e. g., Pattern). In addition to the (shared) value,
+ *  %ValueChangeDeltaEvent contains the list of changes since the emission
+ *  of the previous event. Merged events append their changes.
+ */
+template <typename T, typename V>
+class ValueChangeDeltaEvent : public ValueChangeTypedEvent<V>
+{
+protected:
+	std::vector<T> changes_;
+
+public:
+
+    /**
+     *  @brief  Creates an empty %ValueChangeDeltaEvent.
+     */
+	ValueChangeDeltaEvent () :
+		ValueChangeDeltaEvent (nullptr, std::make_shared<const V> (), std::vector<T> ())
+    {
+
+    }
+
+    /**
+     *  @brief  Creates a %ValueChangeDeltaEvent.
+     *  @param widget  Pointer to the widget which caused the %Event.
+     *  @param value  Shared pointer to the value. Must not be nullptr.
+     *  @param changes  List of changes.
+     */
+	ValueChangeDeltaEvent (BWidgets::Widget* widget, const std::shared_ptr<const V>& value, const std::vector<T>& changes) :
+		ValueChangeTypedEvent<V> (widget, value),
+        changes_ (changes)
+    {
+
+    }
+
+    /**
+	 *  @brief  Takes over the value and appends the changes from another
+     *  event.
+	 *  @param that  Other event.
+     *
+     *  The value and the changes are only taken over if @a that is
+     *  compatible to @a this .
+     *  Note: This method doesn't change the value within a widget!
+	 */
+    virtual void setValue (Event* that) override
+    {
+        ValueChangeTypedEvent<V>::setValue (that);
+        ValueChangeDeltaEvent<T, V>* ev = dynamic_cast<ValueChangeDeltaEvent<T, V>*>(that);
+        if (ev) changes_.insert (changes_.end(), ev->changes_.begin(), ev->changes_.end());
+    }
+
+    using ValueChangeTypedEvent<V>::setValue;
+
+	/**
+	 *  Gets the changes exposed by the event.
+	 *  @return  List of changes in the order of their appearance.
+	 */
+	const std::vector<T>& getChanges () const
+	{
+        return changes_;
+    }
+};
+
+}
+
+#endif /* BEVENTS_VALUECHANGEDELTAEVENT_HPP_ */
@@ -20,6 +20,7 @@
 
 #include "Event.hpp"
 #include "ValueChangedEvent.hpp"
+#include <memory>
 
 namespace BEvents
 {
@@ -29,13 +30,15 @@ namespace BEvents
  *  @tparam  Value type (default = float)
  *
  *  Specialization of ValueChangedEvent. %ValueChangeTypedEvent additionally
- *  contains a copy of the value from the time of emission of the event.
+ *  contains a copy of the value from the time of emission of the event. The
+ *  copy is held as a shared, immutable payload. Thus, merging events and
+ *  copying events don't copy the value.
  */
 template <typename T = float>
 class ValueChangeTypedEvent : public ValueChangedEvent
 {
 protected:
-	T value_;
+	std::shared_ptr<const T> value_;
 
 public:
 
@@ -43,7 +46,7 @@ public:
      *  @brief  Creates an empty %ValueChangeTypedEvent.
      */
 	ValueChangeTypedEvent () :
-		ValueChangeTypedEvent (nullptr, 0.0) 
+		ValueChangeTypedEvent (nullptr, T()) 
     {
 
     }
@@ -53,7 +56,18 @@ public:
      *  @param widget  Pointer to the widget which caused the %Event.
      *  @param value  Value.
      */
-	ValueChangeTypedEvent (BWidgets::Widget* widget, const T value) :
+	ValueChangeTypedEvent (BWidgets::Widget* widget, const T& value) :
+		ValueChangeTypedEvent (widget, std::make_shared<const T> (value)) 
+    {
+
+    }
+
+    /**
+     *  @brief  Creates a %ValueChangeTypedEvent with a shared value.
+     *  @param widget  Pointer to the widget which caused the %Event.
+     *  @param value  Shared pointer to the value. Must not be nullptr.
+     */
+	ValueChangeTypedEvent (BWidgets::Widget* widget, const std::shared_ptr<const T>& value) :
 		ValueChangedEvent (widget), 
         value_ (value) 
     {
@@ -70,7 +84,8 @@ public:
 	 */
     virtual void setValue (Event* that) override
     {
-        if (dynamic_cast<ValueChangeTypedEvent<T>*>(that)) setValue (dynamic_cast<ValueChangeTypedEvent<T>*>(that)->value_);
+        ValueChangeTypedEvent<T>* ev = dynamic_cast<ValueChangeTypedEvent<T>*>(that);
+        if (ev) value_ = ev->value_;
     }
 
 	/**
@@ -81,14 +96,23 @@ public:
 	 */
 	virtual void setValue (const T val)
 	{
-        value_ = val;
+        value_ = std::make_shared<const T> (val);
     }
 
 	/**
 	 *  Gets the value exposed by the event.
 	 *  @return Value of the event.
 	 */
-	T getValue () const
+	const T& getValue () const
+	{
+        return *value_;
+    }
+
+	/**
+	 *  Gets the shared value exposed by the event.
+	 *  @return Shared pointer to the value of the event.
+	 */
+	std::shared_ptr<const T> getSharedValue () const
 	{
         return value_;
     }
@@ -0,0 +1,377 @@
+/* PeakPyramid.hpp
+ * Pattern-controlled audio stream / sample re-sequencer LV2 plugin
+ *
+ * Copyright (C) 2020 - 2022 by Sven Jähnichen
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+#ifndef BMUSIC_PEAKPYRAMID_HPP_
+#define BMUSIC_PEAKPYRAMID_HPP_
+
+#include <cstdint>
+#include <cmath>
+#include <vector>
+#include <algorithm>
+#include <atomic>
+
+#ifndef BMUSIC_DEFAULT_PEAKPYRAMID_BLOCKSIZE
+#define BMUSIC_DEFAULT_PEAKPYRAMID_BLOCKSIZE 256
+#endif
+
+namespace BMusic
+{
+
+/**
+ *  @brief  Multi-resolution min / max / RMS summary of interleaved audio
+ *  data.
+ *
+ *  The base level of a %PeakPyramid stores the minimum, the maximum, and the
+ *  mean square for each channel and each block of
+ *  @c BMUSIC_DEFAULT_PEAKPYRAMID_BLOCKSIZE frames. Each further level
+ *  combines two entries of the level below. Thus, the peaks of any frame
+ *  range can be determined by visiting only a few entries, independent of
+ *  the range size.
+ *
+ *  %PeakPyramid doesn't keep the audio data itself. Ranges shorter than a
+ *  block are directly evaluated from the audio data passed to @c get() .
+ *
+ *  A %PeakPyramid can also be built progressively while the audio data is
+ *  loaded (see @c reset() , @c append() , and @c finish() ). During a
+ *  progressive build, @c get() may be called from another (single) thread.
+ */
+class PeakPyramid
+{
+public:
+
+    /**
+     *  @brief  Summary of a frame range of a single channel.
+     */
+    struct Peak
+    {
+        float min;
+        float max;
+        float rms;
+    };
+
+protected:
+
+    struct Entry
+    {
+        float min;
+        float max;
+        float ms;
+    };
+
+    int64_t frames_;
+    int channels_;
+    std::vector<std::vector<Entry>> levels_;
+    std::atomic<int64_t> valid_;        // Frames summarized on the base level
+    std::atomic<size_t> nrLevels_;      // Levels ready to use
+
+public:
+
+    /**
+     *  @brief  Constructs an empty %PeakPyramid.
+     */
+    PeakPyramid () : frames_ (0), channels_ (0), levels_ (), valid_ (0), nrLevels_ (0) {}
+
+    /**
+     *  @brief  Constructs a %PeakPyramid from interleaved audio data.
+     *  @param data  Pointer to the interleaved audio data.
+     *  @param frames  Number of frames.
+     *  @param channels  Number of channels.
+     */
+    PeakPyramid (const float* data, const int64_t frames, const int channels) :
+        PeakPyramid ()
+    {
+        build (data, frames, channels);
+    }
+
+    /**
+     *  @brief  Copy constructor. Must not be called during a progressive
+     *  build of @a that.
+     *  @param that  Other %PeakPyramid.
+     */
+    PeakPyramid (const PeakPyramid& that) :
+        frames_ (that.frames_),
+        channels_ (that.channels_),
+        levels_ (that.levels_),
+        valid_ (that.valid_.load()),
+        nrLevels_ (that.nrLevels_.load())
+    {
+
+    }
+
+    /**
+     *  @brief  Copy assignment operator. Must not be called during a 
+     *  progressive build of @a that.
+     *  @param that  Other %PeakPyramid.
+     *  @return  Copied %PeakPyramid.
+     */
+    PeakPyramid& operator= (const PeakPyramid& that)
+    {
+        frames_ = that.frames_;
+        channels_ = that.channels_;
+        levels_ = that.levels_;
+        valid_.store (that.valid_.load());
+        nrLevels_.store (that.nrLevels_.load());
+        return *this;
+    }
+
+    /**
+     *  @brief  (Re-)builds the %PeakPyramid from interleaved audio data.
+     *  @param data  Pointer to the interleaved audio data.
+     *  @param frames  Number of frames.
+     *  @param channels  Number of channels.
+     */
+    void build (const float* data, const int64_t frames, const int channels)
+    {
+        reset (frames, channels);
+        append (data, frames);
+        finish ();
+    }
+
+    /**
+     *  @brief  Prepares an empty %PeakPyramid for a progressive build.
+     *  @param frames  Number of frames.
+     *  @param channels  Number of channels.
+     *
+     *  Allocates all levels. Audio data can then be summarized using
+     *  @c append() or @c appendBlock() as soon as it becomes available. A
+     *  progressive build is completed by @c finish() . Must not be called
+     *  while another thread reads from the %PeakPyramid.
+     */
+    void reset (const int64_t frames, const int channels)
+    {
+        clear ();
+        if ((frames <= 0) || (channels <= 0)) return;
+
+        frames_ = frames;
+        channels_ = channels;
+        const int64_t bs = BMUSIC_DEFAULT_PEAKPYRAMID_BLOCKSIZE;
+        size_t nr = (frames + bs - 1) / bs;
+        levels_.push_back (std::vector<Entry> (nr * channels));
+        while (nr > 1)
+        {
+            nr = (nr + 1) / 2;
+            levels_.push_back (std::vector<Entry> (nr * channels));
+        }
+        nrLevels_.store (1, std::memory_order_release);
+    }
+
+    /**
+     *  @brief  Summarizes newly available audio data on the base level.
+     *  @param data  Pointer to the interleaved audio data (starting with
+     *  frame 0).
+     *  @param to  Frame after the last available frame.
+     *
+     *  Only complete blocks (and the final block) not yet summarized are
+     *  evaluated. Until @c finish() is called, @c get() only covers the
+     *  summarized frames.
+     */
+    void append (const float* data, const int64_t to)
+    {
+        if (!data) return;
+        const int64_t from = valid_.load (std::memory_order_relaxed);
+        if (to > from) appendBlock (data + from * channels_, to - from);
+    }
+
+    /**
+     *  @brief  Summarizes the next block of audio data on the base level.
+     *  @param block  Pointer to the interleaved audio data starting with
+     *  the first frame not yet summarized (see @c getValidFrames() ).
+     *  @param frames  Number of frames in @a block. Must be a multiple of
+     *  @c BMUSIC_DEFAULT_PEAKPYRAMID_BLOCKSIZE unless @a block includes 
+     *  the final frame.
+     *
+     *  Allows to build the %PeakPyramid from streamed audio data.
+     */
+    void appendBlock (const float* block, const int64_t frames)
+    {
+        if ((!block) || empty() || (nrLevels_.load (std::memory_order_relaxed) != 1)) return;
+
+        const int64_t bs = BMUSIC_DEFAULT_PEAKPYRAMID_BLOCKSIZE;
+        const int64_t from = valid_.load (std::memory_order_relaxed);
+        const int64_t end = std::min (from + frames, frames_);
+        const int64_t b1 = (end == frames_ ? (frames_ + bs - 1) / bs : end / bs);
+        std::vector<Entry>& base = levels_.front();
+        for (int64_t b = (from + bs - 1) / bs; b < b1; ++b)
+        {
+            const int64_t f0 = b * bs;
+            const int64_t f1 = std::min (f0 + bs, frames_);
+            for (int c = 0; c < channels_; ++c)
+            {
+                float mn = block[(f0 - from) * channels_ + c];
+                float mx = mn;
+                double sumSq = 0.0;
+                for (int64_t f = f0; f < f1; ++f)
+                {
+                    const float s = block[(f - from) * channels_ + c];
+                    mn = std::min (mn, s);
+                    mx = std::max (mx, s);
+                    sumSq += double (s) * double (s);
+                }
+                base[b * channels_ + c] = Entry {mn, mx, float (sumSq / double (f1 - f0))};
+            }
+        }
+        valid_.store (std::max (from, std::min (b1 * bs, frames_)), std::memory_order_release);
+    }
+
+    /**
+     *  @brief  Completes a progressive build by calculating all levels above
+     *  the base level.
+     */
+    void finish ()
+    {
+        if (empty() || (nrLevels_.load (std::memory_order_relaxed) != 1)) return;
+
+        for (size_t l = 1; l < levels_.size(); ++l)
+        {
+            const std::vector<Entry>& lower = levels_[l - 1];
+            std::vector<Entry>& upper = levels_[l];
+            const size_t nrLower = lower.size() / channels_;
+            for (size_t i = 0; i < nrLower; i += 2)
+            {
+                for (int c = 0; c < channels_; ++c)
+                {
+                    const Entry& e1 = lower[i * channels_ + c];
+                    if (i + 1 < nrLower)
+                    {
+                        const Entry& e2 = lower[(i + 1) * channels_ + c];
+                        upper[(i / 2) * channels_ + c] = Entry {std::min (e1.min, e2.min), std::max (e1.max, e2.max), 0.5f * (e1.ms + e2.ms)};
+                    }
+                    else upper[(i / 2) * channels_ + c] = e1;
+                }
+            }
+        }
+        nrLevels_.store (levels_.size(), std::memory_order_release);
+    }
+
+    /**
+     *  @brief  Gets the number of frames summarized so far.
+     *  @return  Number of frames.
+     */
+    int64_t getValidFrames () const {return valid_.load (std::memory_order_acquire);}
+
+    /**
+     *  @brief  Removes all data from the %PeakPyramid.
+     */
+    void clear ()
+    {
+        frames_ = 0;
+        channels_ = 0;
+        levels_.clear();
+        valid_.store (0);
+        nrLevels_.store (0);
+    }
+
+    /**
+     *  @brief  Checks if the %PeakPyramid is empty.
+     *  @return  True if empty, otherwise false.
+     */
+    bool empty () const {return levels_.empty();}
+
+    /**
+     *  @brief  Gets the summary of a frame range.
+     *  @param data  Pointer to the interleaved audio data used to build the
+     *  %PeakPyramid or nullptr if not available (e.g., streamed data).
+     *  @param from  First frame.
+     *  @param to  Frame after the last frame.
+     *  @param channel  Channel.
+     *  @return  Minimum, maximum, and RMS of the frame range.
+     *
+     *  Ranges with at least one block (or any range if @a data is nullptr)
+     *  are evaluated block-wise on the highest suitable level. Thus, the
+     *  result may include up to one block before and after the range.
+     *  Frames not summarized yet are ignored.
+     */
+    Peak get (const float* data, const int64_t from, const int64_t to, const int channel) const
+    {
+        const int64_t f0 = std::max (from, int64_t (0));
+        const int64_t f1 = std::min (to, valid_.load (std::memory_order_acquire));
+        if (empty() || (f1 <= f0) || (channel < 0) || (channel >= channels_)) return Peak {0.0f, 0.0f, 0.0f};
+
+        const int64_t bs = BMUSIC_DEFAULT_PEAKPYRAMID_BLOCKSIZE;
+
+        // Short ranges: Direct access
+        if (data && (f1 - f0 < bs))
+        {
+            float mn = data[f0 * channels_ + channel];
+            float mx = mn;
+            double sumSq = 0.0;
+            for (int64_t f = f0; f < f1; ++f)
+            {
+                const float s = data[f * channels_ + channel];
+                mn = std::min (mn, s);
+                mx = std::max (mx, s);
+                sumSq += double (s) * double (s);
+            }
+            return Peak {mn, mx, float (std::sqrt (sumSq / double (f1 - f0)))};
+        }
+
+        // Find highest level with at least two entries in range
+        const size_t nrLevels = nrLevels_.load (std::memory_order_acquire);
+        size_t level = 0;
+        int64_t span = bs;
+        while ((level + 1 < nrLevels) && (2 * span * 2 <= f1 - f0))
+        {
+            ++level;
+            span *= 2;
+        }
+
+        const std::vector<Entry>& entries = levels_[level];
+        const int64_t i0 = f0 / span;
+        const int64_t i1 = std::min ((f1 - 1) / span, int64_t (entries.size() / channels_) - 1);
+        float mn = entries[i0 * channels_ + channel].min;
+        float mx = entries[i0 * channels_ + channel].max;
+        double ms = 0.0;
+        for (int64_t i = i0; i <= i1; ++i)
+        {
+            const Entry& e = entries[i * channels_ + channel];
+            mn = std::min (mn, e.min);
+            mx = std::max (mx, e.max);
+            ms += e.ms;
+        }
+        return Peak {mn, mx, float (std::sqrt (ms / double (i1 - i0 + 1)))};
+    }
+
+    /**
+     *  @brief  Gets the absolute maximum of all frames of a channel.
+     *  @param channel  Channel.
+     *  @return  Absolute maximum (of the frames summarized so far).
+     */
+    float getMaxAbs (const int channel) const
+    {
+        if (empty() || (channel < 0) || (channel >= channels_)) return 0.0f;
+
+        // Not finished: Scan the summarized part of the base level
+        const bool finished = (nrLevels_.load (std::memory_order_acquire) == levels_.size());
+        const std::vector<Entry>& entries = (finished ? levels_.back() : levels_.front());
+        const int64_t bs = BMUSIC_DEFAULT_PEAKPYRAMID_BLOCKSIZE;
+        const size_t nr = (finished ? 1 : (getValidFrames() + bs - 1) / bs);
+        float mx = 0.0f;
+        for (size_t i = 0; i < nr; ++i)
+        {
+            const Entry& e = entries[i * channels_ + channel];
+            mx = std::max (mx, std::max (std::fabs (e.min), std::fabs (e.max)));
+        }
+        return mx;
+    }
+};
+
+}
+
+#endif /* BMUSIC_PEAKPYRAMID_HPP_ */
@@ -0,0 +1,271 @@
+/* Resampler.hpp
+ * Pattern-controlled audio stream / sample re-sequencer LV2 plugin
+ *
+ * Copyright (C) 2020 - 2022 by Sven Jähnichen
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+#ifndef BMUSIC_RESAMPLER_HPP_
+#define BMUSIC_RESAMPLER_HPP_
+
+#include <cstdint>
+#include <cmath>
+#include <vector>
+#include <algorithm>
+
+#ifndef BMUSIC_DEFAULT_RESAMPLER_PHASES
+#define BMUSIC_DEFAULT_RESAMPLER_PHASES 128
+#endif
+
+#ifndef BMUSIC_DEFAULT_RESAMPLER_ROLLOFF
+#define BMUSIC_DEFAULT_RESAMPLER_ROLLOFF 0.95
+#endif
+
+namespace BMusic
+{
+
+/**
+ *  @brief  Block-based polyphase resampler for interleaved audio data.
+ *
+ *  %Resampler renders whole blocks of output frames from a source buffer at
+ *  any (fractional) source position and with any step size. The
+ *  interpolation kernel is taken from a precalculated polyphase table with
+ *  @c BMUSIC_DEFAULT_RESAMPLER_PHASES phases (linearly interpolated between
+ *  neighboring phases). The quality determines the kernel:
+ *  - LINEAR: Linear interpolation (2 taps, no anti-aliasing).
+ *  - LOW: Blackman-windowed sinc, 8 taps.
+ *  - MEDIUM: Blackman-windowed sinc, 16 taps.
+ *  - HIGH: Blackman-windowed sinc, 32 taps.
+ *
+ *  For downsampling, the sinc cutoff is lowered with the step size to avoid
+ *  aliasing. The kernel table only changes upon @c setQuality() or
+ *  @c setRates() . Thus, @c process() is free of memory allocation and
+ *  consists of plain multiply-add loops over contiguous kernel rows.
+ */
+class Resampler
+{
+public:
+
+    /**
+     *  @brief  Enumeration of resampling qualities.
+     */
+    enum Quality
+    {
+        LINEAR,
+        LOW,
+        MEDIUM,
+        HIGH
+    };
+
+protected:
+
+    Quality quality_;
+    double step_;               // Source frames per output frame
+    int taps_;
+    std::vector<float> table_;  // (phases + 1) x taps
+    std::vector<float> kernel_;
+
+public:
+
+    /**
+     *  @brief  Constructs a %Resampler.
+     *  @param quality  Optional, resampling quality.
+     *  @param sourceRate  Optional, frame rate of the source data.
+     *  @param targetRate  Optional, frame rate of the output data.
+     */
+    Resampler (const Quality quality = MEDIUM, const double sourceRate = 48000.0, const double targetRate = 48000.0) :
+        quality_ (quality),
+        step_ (1.0),
+        taps_ (2),
+        table_ (),
+        kernel_ ()
+    {
+        setRates (sourceRate, targetRate);
+    }
+
+    /**
+     *  @brief  Sets the resampling quality.
+     *  @param quality  LINEAR, LOW, MEDIUM, or HIGH.
+     */
+    void setQuality (const Quality quality)
+    {
+        if (quality != quality_)
+        {
+            quality_ = quality;
+            makeTable ();
+        }
+    }
+
+    /**
+     *  @brief  Gets the resampling quality.
+     *  @return  LINEAR, LOW, MEDIUM, or HIGH.
+     */
+    Quality getQuality () const {return quality_;}
+
+    /**
+     *  @brief  Sets the source and the target frame rate.
+     *  @param sourceRate  Frame rate of the source data.
+     *  @param targetRate  Frame rate of the output data.
+     */
+    void setRates (const double sourceRate, const double targetRate)
+    {
+        const double step = ((sourceRate > 0.0) && (targetRate > 0.0) ? sourceRate / targetRate : 1.0);
+        if ((step != step_) || table_.empty())
+        {
+            step_ = step;
+            makeTable ();
+        }
+    }
+
+    /**
+     *  @brief  Gets the step size.
+     *  @return  Source frames per output frame.
+     */
+    double getStep () const {return step_;}
+
+    /**
+     *  @brief  Gets the number of kernel taps.
+     *  @return  Number of taps.
+     */
+    int getTaps () const {return taps_;}
+
+    /**
+     *  @brief  Renders a block of resampled output frames.
+     *  @param source  Pointer to the interleaved source data.
+     *  @param sourceFrames  Number of frames in @a source.
+     *  @param channels  Number of channels in @a source and @a dest.
+     *  @param position  Source position (in source frames) of the first
+     *  output frame.
+     *  @param dest  Pointer to the interleaved output buffer. Must be able
+     *  to take up @a frames x @a channels values.
+     *  @param frames  Number of output frames.
+     *  @return  Source position of the next output frame.
+     *
+     *  Source frames outside @a source are treated as silence.
+     */
+    double process  (const float* source, const int64_t sourceFrames, const int channels,
+                     const double position, float* dest, const int64_t frames)
+    {
+        if ((!source) || (!dest) || (channels <= 0)) return position;
+
+        const int half = taps_ / 2;
+        const int phases = BMUSIC_DEFAULT_RESAMPLER_PHASES;
+        float* kernel = kernel_.data();
+        double pos = position;
+
+        for (int64_t i = 0; i < frames; ++i, pos += step_)
+        {
+            const double fl = std::floor (pos);
+            const int64_t p0 = int64_t (fl) - half + 1;
+            const double ph = (pos - fl) * phases;
+            const int phi = std::min (int (ph), phases - 1);
+            const float phf = ph - phi;
+
+            // Interpolate kernel between phases
+            const float* k0 = table_.data() + phi * taps_;
+            const float* k1 = k0 + taps_;
+            for (int t = 0; t < taps_; ++t) kernel[t] = k0[t] + phf * (k1[t] - k0[t]);
+
+            float* d = dest + i * channels;
+
+            // Fast path: Kernel fully inside source
+            if ((p0 >= 0) && (p0 + taps_ <= sourceFrames))
+            {
+                const float* s = source + p0 * channels;
+                for (int c = 0; c < channels; ++c)
+                {
+                    float sum = 0.0f;
+                    for (int t = 0; t < taps_; ++t) sum += kernel[t] * s[t * channels + c];
+                    d[c] = sum;
+                }
+            }
+
+            // Margins
+            else
+            {
+                for (int c = 0; c < channels; ++c)
+                {
+                    float sum = 0.0f;
+                    for (int t = 0; t < taps_; ++t)
+                    {
+                        const int64_t p = p0 + t;
+                        if ((p >= 0) && (p < sourceFrames)) sum += kernel[t] * source[p * channels + c];
+                    }
+                    d[c] = sum;
+                }
+            }
+        }
+
+        return pos;
+    }
+
+protected:
+
+    void makeTable ()
+    {
+        switch (quality_)
+        {
+            case LOW:       taps_ = 8;
+                            break;
+            case MEDIUM:    taps_ = 16;
+                            break;
+            case HIGH:      taps_ = 32;
+                            break;
+            default:        taps_ = 2;
+        }
+
+        const int phases = BMUSIC_DEFAULT_RESAMPLER_PHASES;
+        const int half = taps_ / 2;
+        const double cutoff = BMUSIC_DEFAULT_RESAMPLER_ROLLOFF * std::min (1.0, 1.0 / step_);
+        table_.assign ((phases + 1) * taps_, 0.0f);
+        kernel_.assign (taps_, 0.0f);
+
+        for (int ph = 0; ph <= phases; ++ph)
+        {
+            const double frac = double (ph) / double (phases);
+            float* row = table_.data() + ph * taps_;
+            double sum = 0.0;
+
+            for (int t = 0; t < taps_; ++t)
+            {
+                const double x = double (t - half + 1) - frac;
+                double h;
+
+                if (quality_ == LINEAR) h = std::max (0.0, 1.0 - std::fabs (x));
+                else
+                {
+                    const double sinc = (x == 0.0 ? 1.0 : std::sin (M_PI * cutoff * x) / (M_PI * cutoff * x));
+                    const double wx = x / double (half);
+                    const double window = (std::fabs (wx) < 1.0 ? 0.42 + 0.5 * std::cos (M_PI * wx) + 0.08 * std::cos (2.0 * M_PI * wx) : 0.0);
+                    h = sinc * window;
+                }
+
+                row[t] = h;
+                sum += h;
+            }
+
+            // Unity gain
+            if (sum != 0.0)
+            {
+                for (int t = 0; t < taps_; ++t) row[t] /= sum;
+            }
+        }
+    }
+};
+
+}
+
+#endif /* BMUSIC_RESAMPLER_HPP_ */
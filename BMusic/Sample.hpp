@@ -23,10 +23,17 @@
 
 #include "sndfile.h"
 #include <cstdlib>
+#include <cstdint>
 #include <cstring>
 #include <cmath>
 #include <string>
 #include <stdexcept>
+#include <functional>
+#include <algorithm>
+#include <memory>
+#include <vector>
+#include "PeakPyramid.hpp"
+#include "SampleStream.hpp"
 
 #ifndef SF_FORMAT_MP3
 #ifndef MINIMP3_FLOAT_OUTPUT
@@ -35,15 +42,39 @@
 #include "minimp3/minimp3_ex.h"
 #endif /* SF_FORMAT_MP3 */
 
+#ifndef BMUSIC_DEFAULT_SAMPLE_BLOCKSIZE
+#define BMUSIC_DEFAULT_SAMPLE_BLOCKSIZE 65536
+#endif
+
+#ifndef BMUSIC_DEFAULT_SAMPLE_ALIGNMENT
+#define BMUSIC_DEFAULT_SAMPLE_ALIGNMENT 64
+#endif
+
+#ifndef BMUSIC_DEFAULT_SAMPLE_MAX_LOAD_SIZE
+#define BMUSIC_DEFAULT_SAMPLE_MAX_LOAD_SIZE 134217728
+#endif
+
 namespace BMusic
 {
 
+static_assert (BMUSIC_DEFAULT_SAMPLE_BLOCKSIZE % BMUSIC_DEFAULT_PEAKPYRAMID_BLOCKSIZE == 0, "Sample block size must be a multiple of the peak pyramid block size");
+
 /**
  *  @brief  Class to load, handle, and process sound (sample) data from sound
  *  files. 
  *
  *  A %Sample consists of the sound file meta data (format, file name, extension,
  *  path), the audio binary data, and the sample meta data (region, loop).
+ *
+ *  The audio binary data are shared between copies of a %Sample (reference
+ *  counted) and thus must be treated as read-only. Copies are cheap. Sound 
+ *  files with more than @c BMUSIC_DEFAULT_SAMPLE_MAX_LOAD_SIZE samples (frames
+ *  x channels) aren't loaded into memory (@c data is nullptr) but streamed
+ *  via @c stream on access.
+ *
+ *  Optionally, a planar copy of the audio data with aligned per-channel
+ *  buffers can be created by @c makePlanar() . Use @c read() or
+ *  @c getSpan() to access blocks of frames of a single channel.
 
  *  %Sample uses the sndfile library to load sound files. Thus, all file types
  *  supported by sndfiles are supported by %Sample too. In addition, %Sample
@@ -54,12 +85,26 @@ namespace BMusic
  */
 struct Sample
 {
-        SF_INFO         info;      // Info about sample from sndfile
-        float*          data;      // %Sample data in float
-        char*           path;      // Path of file
-        bool            loop;      // Loop playing mode
-        sf_count_t      start;     // Start frame
-        sf_count_t      end;       // End frame
+        SF_INFO                         info;      // Info about sample from sndfile
+        float*                          data;      // %Sample data in float, nullptr if streamed
+        char*                           path;      // Path of file
+        bool                            loop;      // Loop playing mode
+        sf_count_t                      start;     // Start frame
+        sf_count_t                      end;       // End frame
+        std::shared_ptr<float>          buffer;    // Owner of data (shared)
+        std::shared_ptr<SampleStream>   stream;    // Streamed data if not loaded (shared)
+        std::shared_ptr<PeakPyramid>    peaks;     // Min / max / RMS overview of data (shared)
+        std::shared_ptr<float>          planarBuffer;  // Owner of planar (shared)
+        float*                          planar;    // Planar data, nullptr if not created
+        sf_count_t                      planarStride;  // Distance between channels in planar
+
+        /**
+         *  @brief  Function called during loading. Takes the %Sample under
+         *  construction, the number of frames available in data (from the
+         *  start), and the progress (0.0 .. 1.0). Returns false to cancel
+         *  loading.
+         */
+        typedef std::function<bool (Sample& sample, const sf_count_t frames, const double progress)> ProgressFunction;
 
         /**
          * @brief Constructs a new empty Sample object.
@@ -72,9 +117,24 @@ struct Sample
          */
         Sample (const char* samplepath);
 
+        /**
+         *  @brief  Constructs a new %Sample object from a filename / path and
+         *  reports the loading progress.
+         *  @param samplepath  Path and filename to the sample.
+         *  @param progress  Function called after each loaded block.
+         *
+         *  Sound files are loaded in blocks of 
+         *  @c BMUSIC_DEFAULT_SAMPLE_BLOCKSIZE frames. @a progress is called
+         *  after each block with the number of frames loaded so far. @c peaks
+         *  covers the frames loaded so far and may be read from another 
+         *  thread during loading. The last call of @a progress takes all
+         *  frames. Throws std::runtime_error if @a progress returns false.
+         */
+        Sample (const char* samplepath, ProgressFunction progress);
+
         /**
          *  @brief  Copy constructor. Constructs a new %Sample object from 
-         *  another one.
+         *  another one. Shares the audio data.
          *  @param that  Other %Sample object.
          */
         Sample (const Sample& that);
@@ -83,7 +143,7 @@ struct Sample
 
         /**
          *  @brief  Copy assignment operator. Copies the %Sample from another
-         *  object. 
+         *  object. Shares the audio data.
          *  @param that  Other object.
          *  @return  Copied %Sample.
          */
@@ -95,8 +155,64 @@ struct Sample
          *  @param channel  Channel number.
          *  @param rate  Frame rate.
          *  @return float  Sample value.
+         *
+         *  Uses linear interpolation if @a rate differs from the sample
+         *  frame rate. Use Resampler to render whole blocks at other frame
+         *  rates in higher quality.
          */
         float get (const sf_count_t frame, const int channel, const int rate);
+
+        /**
+         *  @brief  Gets minimum, maximum, and RMS of a frame range.
+         *  @param from  First frame.
+         *  @param to  Frame after the last frame.
+         *  @param channel  Channel number.
+         *  @return  Peak data of the frame range.
+         *
+         *  Uses the peak pyramid built upon loading the sample. Thus, the 
+         *  costs are independent of the range size. Streamed samples are
+         *  evaluated with a resolution of 
+         *  @c BMUSIC_DEFAULT_PEAKPYRAMID_BLOCKSIZE frames.
+         */
+        PeakPyramid::Peak getPeak (const sf_count_t from, const sf_count_t to, const int channel) const;
+
+        /**
+         *  @brief  Creates a planar (deinterleaved) copy of the audio data.
+         *  @return  True on success, false if no data are loaded (e.g., 
+         *  streamed).
+         *
+         *  Each channel is stored in its own buffer aligned to
+         *  @c BMUSIC_DEFAULT_SAMPLE_ALIGNMENT bytes. The planar copy is 
+         *  shared between copies of the %Sample.
+         */
+        bool makePlanar ();
+
+        /**
+         *  @brief  Gets a pointer to contiguous frames of a single channel.
+         *  @param frame  First frame.
+         *  @param channel  Channel number.
+         *  @param frames  Reference to the number of frames requested. Takes
+         *  up the number of frames available until @c end .
+         *  @return  Pointer to the planar data of @a frame, or nullptr if
+         *  no planar data are available or @a frame is outside the region.
+         */
+        const float* getSpan (const sf_count_t frame, const int channel, sf_count_t& frames) const;
+
+        /**
+         *  @brief  Copies a block of frames of a single channel of the
+         *  region between @c start and @c end .
+         *  @param dest  Pointer to the destination buffer. Must be able to
+         *  take up @a frames values.
+         *  @param frame  First frame.
+         *  @param channel  Channel number.
+         *  @param frames  Number of frames.
+         *  @return  Frame following the copied block.
+         *
+         *  Continues with @c start if the copy reaches @c end and @c loop is
+         *  set. Otherwise, frames outside the region are filled with
+         *  silence. Uses planar data if available.
+         */
+        sf_count_t read (float* dest, const sf_count_t frame, const int channel, const sf_count_t frames) const;
 };
 
 inline Sample::Sample () : 
@@ -105,19 +221,36 @@ inline Sample::Sample () :
     path (nullptr) ,
     loop (false),
     start (0),
-    end (0)
-    
+    end (0),
+    buffer (),
+    stream (),
+    peaks (std::make_shared<PeakPyramid>()),
+    planarBuffer (),
+    planar (nullptr),
+    planarStride (0)
 {
 
 }
 
 inline Sample::Sample (const char* samplepath) :
+    Sample (samplepath, nullptr)
+{
+
+}
+
+inline Sample::Sample (const char* samplepath, ProgressFunction progress) :
     info {0, 0, 0, 0, 0, 0}, 
     data (nullptr), 
     path (nullptr),
     loop (false), 
     start (0), 
-    end (0)
+    end (0),
+    buffer (),
+    stream (),
+    peaks (std::make_shared<PeakPyramid>()),
+    planarBuffer (),
+    planar (nullptr),
+    planarStride (0)
 {
     if (!samplepath) return;
 
@@ -127,6 +260,15 @@ inline Sample::Sample (const char* samplepath) :
     memcpy (path, samplepath, len + 1);
     if (!len) return;
 
+    // Free path if loading fails. The destructor isn't called if the
+    // constructor throws.
+    struct PathGuard
+    {
+        char*& p;
+        bool active;
+        ~PathGuard () {if (active && p) {free (p); p = nullptr;}}
+    } pathGuard {path, true};
+
     // Extract file name
     char* name = strrchr (path, '/') + 1;
     if (!name) name = path;
@@ -139,23 +281,47 @@ inline Sample::Sample (const char* samplepath) :
     if ((extsz > 1) && (extsz < 16)) memcpy (ext, extptr, extsz);
     for (char* s = ext; *s; ++s) *s = tolower ((unsigned char)*s);
 
+    const std::string cancelMessage = "Loading " + std::string (name) + " cancelled.";
 
     // Check for known non-sndfiles
 #ifndef SF_FORMAT_MP3
     if (!strcmp (ext, ".mp3"))
     {
         mp3dec_t mp3dec;
-        mp3dec_file_info_t mp3info;
-        if (mp3dec_load (&mp3dec, path, &mp3info, NULL, NULL)) throw std::invalid_argument ("Can't open " + std::string (name) + ".");
+        mp3dec_file_info_t mp3info {};
+
+        // Progress of the file decoding. No data available yet.
+        struct {Sample* sample; ProgressFunction* progress; bool cancelled;} mp3progress {this, &progress, false};
+        MP3D_PROGRESS_CB mp3cb = [] (void* user_data, size_t file_size, uint64_t offset, mp3dec_frame_info_t* info) -> int
+        {
+            decltype (mp3progress)* p = static_cast<decltype (mp3progress)*> (user_data);
+            const double pr = (file_size ? double (offset) / double (file_size) : 0.0);
+            p->cancelled = !(*p->progress) (*p->sample, 0, std::min (pr, 1.0));
+            return (p->cancelled ? MP3D_E_USER : 0);
+        };
+
+        if (mp3dec_load (&mp3dec, path, &mp3info, (progress ? mp3cb : NULL), &mp3progress))
+        {
+            if (mp3info.buffer) free (mp3info.buffer);
+            if (mp3progress.cancelled) throw std::runtime_error (cancelMessage);
+            throw std::invalid_argument ("Can't open " + std::string (name) + ".");
+        }
+
+        // Take over the decoded buffer (no copy)
+        if (mp3info.buffer) buffer = std::shared_ptr<float> (mp3info.buffer, free);
+        if (mp3progress.cancelled) throw std::runtime_error (cancelMessage);
+
+        if ((!mp3info.buffer) || (!mp3info.samples) || (!mp3info.channels)) throw std::invalid_argument ("Empty sample file " + std::string (name) + ".");
 
         info.samplerate = mp3info.hz;
         info.channels = mp3info.channels;
         info.frames = mp3info.samples / mp3info.channels;
+        data = mp3info.buffer;
 
-        data = (float*) malloc (sizeof(float) * info.frames * info.channels);
-        if (!data) throw std::bad_alloc();
+        peaks->reset (info.frames, info.channels);
+        peaks->append (data, info.frames);
 
-        memcpy (data, mp3info.buffer, sizeof(float) * info.frames * info.channels);
+        if (progress && (!progress (*this, info.frames, 1.0))) throw std::runtime_error (cancelMessage);
     }
 
     else
@@ -165,40 +331,85 @@ inline Sample::Sample (const char* samplepath) :
         SNDFILE* sndfile = sf_open (samplepath, SFM_READ, &info);
 
         //if (!sndfile) throw std::invalid_argument ("Can't open " + std::string (name) + ".");
-        if (sf_error (sndfile) != SF_ERR_NO_ERROR) throw std::invalid_argument (std::string (sf_strerror (sndfile)));
-        if (!info.frames) throw std::invalid_argument ("Empty sample file " + std::string (name) + ".");
+        if (sf_error (sndfile) != SF_ERR_NO_ERROR)
+        {
+            const std::string message = sf_strerror (sndfile);
+            if (sndfile) sf_close (sndfile);
+            throw std::invalid_argument (message);
+        }
 
-        // Read & render data
-        data = (float*) malloc (sizeof(float) * info.frames * info.channels);
-        if (!data)
+        if (!info.frames)
         {
             sf_close (sndfile);
-            throw std::bad_alloc();
+            throw std::invalid_argument ("Empty sample file " + std::string (name) + ".");
+        }
+
+        // Large files: Stream. Otherwise: Read & render data
+        const bool streamed = (info.frames * info.channels > BMUSIC_DEFAULT_SAMPLE_MAX_LOAD_SIZE);
+        std::vector<float> block;
+        if (streamed) block.resize (BMUSIC_DEFAULT_SAMPLE_BLOCKSIZE * info.channels);
+        else
+        {
+            data = (float*) malloc (sizeof(float) * info.frames * info.channels);
+            if (!data)
+            {
+                sf_close (sndfile);
+                throw std::bad_alloc();
+            }
+            buffer = std::shared_ptr<float> (data, free);
         }
 
+        peaks->reset (info.frames, info.channels);
         sf_seek (sndfile, 0, SEEK_SET);
-        sf_read_float (sndfile, data, info.frames * info.channels);
-        sf_close (sndfile);
+        sf_count_t frames = 0;
+        while (frames < info.frames)
+        {
+            const sf_count_t n = std::min (sf_count_t (BMUSIC_DEFAULT_SAMPLE_BLOCKSIZE), info.frames - frames);
+            float* dest = (streamed ? block.data() : data + frames * info.channels);
+            sf_count_t r = 0;
+            while (r < n)
+            {
+                const sf_count_t rr = sf_readf_float (sndfile, dest + r * info.channels, n - r);
+                if (rr <= 0) break;
+                r += rr;
+            }
+
+            // Premature end of file: Fill with silence
+            if (r < n) memset (dest + r * info.channels, 0, sizeof(float) * (n - r) * info.channels);
+
+            peaks->appendBlock (dest, n);
+            frames += n;
+
+            if (progress && (!progress (*this, frames, double (frames) / double (info.frames))))
+            {
+                sf_close (sndfile);
+                throw std::runtime_error (cancelMessage);
+            }
+        }
+
+        if (streamed) stream = std::make_shared<SampleStream> (sndfile, info);
+        else sf_close (sndfile);
     }
 
     end = info.frames;
+    peaks->finish ();
+    pathGuard.active = false;
 }
 
 inline Sample::Sample (const Sample& that) :
     info (that.info), 
-    data (nullptr), 
+    data (that.data), 
     path (nullptr),
     loop (that.loop), 
     start (that.start), 
-    end (that.end)
+    end (that.end),
+    buffer (that.buffer),
+    stream (that.stream),
+    peaks (that.peaks),
+    planarBuffer (that.planarBuffer),
+    planar (that.planar),
+    planarStride (that.planarStride)
     {
-        if (that.data)
-        {
-            data = (float*) malloc (sizeof(float) * info.frames * info.channels);
-            if (!data) throw std::bad_alloc();
-            memcpy (data, that.data, sizeof(float) * info.frames * info.channels);
-        }
-
         if (that.path)
         {
             int len = strlen (that.path);
@@ -210,28 +421,26 @@ inline Sample::Sample (const Sample& that) :
 
 inline Sample::~Sample()
 {
-    if (data) free (data);
     if (path) free (path);
 }
 
 inline Sample& Sample::operator= (const Sample& that)
 {
-    if (data) free (data);
+    if (this == &that) return *this;
     if (path) free (path);
 
     info = that.info;
-    data = nullptr;
+    data = that.data;
     path = nullptr;
     loop = that.loop;
     start = that.start;
     end = that.end;
-
-    if (that.data)
-    {
-        data = (float*) malloc (sizeof(float) * info.frames * info.channels);
-        if (!data) throw std::bad_alloc();
-        memcpy (data, that.data, sizeof(float) * info.frames * info.channels);
-    }
+    buffer = that.buffer;
+    stream = that.stream;
+    peaks = that.peaks;
+    planarBuffer = that.planarBuffer;
+    planar = that.planar;
+    planarStride = that.planarStride;
 
     if (that.path)
     {
@@ -246,29 +455,119 @@ inline Sample& Sample::operator= (const Sample& that)
 
 inline float Sample::get (const sf_count_t frame, const int channel, const int rate)
 {
-    if (!data) return 0.0f;
+    if ((!data) && (!stream)) return 0.0f;
+    if ((frame < 0) || (channel < 0) || (channel >= info.channels)) return 0.0f;
 
     // Direct access if same frame rate
     if (info.samplerate == rate)
     {
         if (frame >= info.frames) return 0.0f;
-        else return data[frame * info.channels + channel];
+        else return (data ? data[frame * info.channels + channel] : stream->get (frame, channel));
     }
 
     // Linear rendering if frame rates differ
-    sf_count_t f = (frame * info.samplerate) / rate;
-        const double frac = fmod (static_cast<double> (f), 1.0);
-    sf_count_t f1 = f;
+    const double pos = double (frame) * double (info.samplerate) / double (rate);
+    const sf_count_t f1 = pos;
+    const double frac = pos - double (f1);
 
     if (f1 >= info.frames) return 0.0f;
 
-    if (frac == 0.0) return data[f1 * info.channels + channel];
+    const float data1 = (data ? data[f1 * info.channels + channel] : stream->get (f1, channel));
+    if (frac == 0.0) return data1;
 
-    float data1 = data[f1 * info.channels + channel];
-    float data2 = (f1 + 1 < info.frames ? data[(f1 + 1) * info.channels + channel] : data1);
+    const float data2 = (f1 + 1 < info.frames ? (data ? data[(f1 + 1) * info.channels + channel] : stream->get (f1 + 1, channel)) : data1);
     return (1.0 - frac) * data1 + frac * data2;
 }
 
+inline PeakPyramid::Peak Sample::getPeak (const sf_count_t from, const sf_count_t to, const int channel) const
+{
+    return (peaks ? peaks->get (data, from, to, channel) : PeakPyramid::Peak {0.0f, 0.0f, 0.0f});
+}
+
+inline bool Sample::makePlanar ()
+{
+    if (planar) return true;
+    if ((!data) || (info.frames <= 0) || (info.channels <= 0)) return false;
+
+    // Round up each channel to the alignment
+    const size_t align = BMUSIC_DEFAULT_SAMPLE_ALIGNMENT;
+    const size_t af = align / sizeof (float);
+    const sf_count_t stride = (info.frames + af - 1) / af * af;
+    void* raw = malloc (sizeof (float) * stride * info.channels + align);
+    if (!raw) throw std::bad_alloc();
+    std::shared_ptr<float> pb = std::shared_ptr<float> (static_cast<float*> (raw), free);
+    float* p = reinterpret_cast<float*> ((reinterpret_cast<uintptr_t> (raw) + align - 1) / align * align);
+
+    for (int c = 0; c < info.channels; ++c)
+    {
+        float* d = p + c * stride;
+        const float* s = data + c;
+        for (sf_count_t f = 0; f < info.frames; ++f) d[f] = s[f * info.channels];
+    }
+
+    planarBuffer = pb;
+    planar = p;
+    planarStride = stride;
+    return true;
+}
+
+inline const float* Sample::getSpan (const sf_count_t frame, const int channel, sf_count_t& frames) const
+{
+    const sf_count_t e = std::min (end, info.frames);
+    if ((!planar) || (channel < 0) || (channel >= info.channels) || (frame < start) || (frame >= e))
+    {
+        frames = 0;
+        return nullptr;
+    }
+
+    frames = std::min (frames, e - frame);
+    return planar + channel * planarStride + frame;
+}
+
+inline sf_count_t Sample::read (float* dest, const sf_count_t frame, const int channel, const sf_count_t frames) const
+{
+    if ((!dest) || (frames <= 0)) return frame;
+
+    const sf_count_t s0 = std::max (start, sf_count_t (0));
+    const sf_count_t e = std::min (end, info.frames);
+    const bool valid = (data || stream) && (channel >= 0) && (channel < info.channels) && (s0 < e);
+    sf_count_t f = frame;
+    sf_count_t i = 0;
+
+    while (i < frames)
+    {
+        // Outside region
+        if ((!valid) || (f < s0) || (f >= e))
+        {
+            if (valid && loop && (f >= e))
+            {
+                f = s0 + (f - s0) % (e - s0);
+                continue;
+            }
+
+            const sf_count_t n = ((f < s0) && valid ? std::min (frames - i, s0 - f) : frames - i);
+            std::fill (dest + i, dest + i + n, 0.0f);
+            i += n;
+            f += n;
+            continue;
+        }
+
+        // Inside region
+        const sf_count_t n = std::min (frames - i, e - f);
+        if (planar) memcpy (dest + i, planar + channel * planarStride + f, sizeof (float) * n);
+        else if (data)
+        {
+            const float* src = data + f * info.channels + channel;
+            for (sf_count_t j = 0; j < n; ++j) dest[i + j] = src[j * info.channels];
+        }
+        else stream->read (dest + i, f, n, channel);
+        i += n;
+        f += n;
+    }
+
+    return f;
+}
+
 }
 
 #endif /* BMUSIC_SAMPLE_HPP_ */
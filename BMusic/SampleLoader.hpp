@@ -0,0 +1,281 @@
+/* SampleLoader.hpp
+ * Pattern-controlled audio stream / sample re-sequencer LV2 plugin
+ *
+ * Copyright (C) 2020 - 2022 by Sven Jähnichen
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+#ifndef BMUSIC_SAMPLELOADER_HPP_
+#define BMUSIC_SAMPLELOADER_HPP_
+
+#include "Sample.hpp"
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <exception>
+
+namespace BMusic
+{
+
+/**
+ *  @brief  Loads a %Sample in the background.
+ *
+ *  %SampleLoader decodes a sound file on a worker thread. Thus, the calling
+ *  (GUI) thread isn't blocked. The progress can be polled by
+ *  @c getProgress() and the waveform of the frames loaded so far by
+ *  @c getPreviewPeak() . A new call of @c load() or a call of @c cancel()
+ *  stops the current loading after the next block. Once the status is
+ *  @c READY, the %Sample can be taken over by @c release() .
+ *
+ *  All methods must be called from the same (owner) thread.
+ */
+class SampleLoader
+{
+public:
+
+    /**
+     *  @brief  Enumeration of loader states.
+     */
+    enum Status
+    {
+        IDLE,
+        LOADING,
+        READY,
+        FAILED
+    };
+
+protected:
+
+    std::thread thread_;
+    mutable std::mutex mutex_;
+    std::atomic<bool> cancel_;
+    std::atomic<int> status_;
+    std::atomic<double> progress_;
+    Sample* sample_;            // Loaded sample, owned until released
+    const Sample* preview_;     // Sample under construction
+    std::string path_;
+    std::string error_;
+
+public:
+
+    /**
+     *  @brief  Constructs an idle %SampleLoader.
+     */
+    SampleLoader () :
+        thread_ (),
+        mutex_ (),
+        cancel_ (false),
+        status_ (IDLE),
+        progress_ (0.0),
+        sample_ (nullptr),
+        preview_ (nullptr),
+        path_ (),
+        error_ ()
+    {
+
+    }
+
+    SampleLoader (const SampleLoader& that) = delete;
+    SampleLoader& operator= (const SampleLoader& that) = delete;
+
+    /**
+     *  @brief  Cancels loading and destructs the %SampleLoader including a
+     *  not released %Sample.
+     */
+    ~SampleLoader ()
+    {
+        cancel ();
+    }
+
+    /**
+     *  @brief  Starts loading a sound file in the background.
+     *  @param path  Path and filename of the sound file.
+     *
+     *  Cancels a running load and discards a not released %Sample first.
+     */
+    void load (const std::string& path)
+    {
+        cancel ();
+
+        cancel_.store (false);
+        progress_.store (0.0);
+        status_.store (LOADING);
+        path_ = path;
+        thread_ = std::thread (&SampleLoader::run, this, path);
+    }
+
+    /**
+     *  @brief  Cancels loading and discards a not released %Sample.
+     *
+     *  Waits until the worker thread stopped. This takes at most the time
+     *  to load a single block.
+     */
+    void cancel ()
+    {
+        cancel_.store (true);
+        if (thread_.joinable()) thread_.join();
+
+        if (sample_) delete sample_;
+        sample_ = nullptr;
+        path_.clear();
+        error_.clear();
+        progress_.store (0.0);
+        status_.store (IDLE);
+    }
+
+    /**
+     *  @brief  Gets the loader status.
+     *  @return  IDLE, LOADING, READY, or FAILED.
+     */
+    Status getStatus () const {return Status (status_.load());}
+
+    /**
+     *  @brief  Gets the loading progress.
+     *  @return  Progress (0.0 .. 1.0).
+     */
+    double getProgress () const {return progress_.load();}
+
+    /**
+     *  @brief  Gets the path of the sound file loaded (or to be loaded).
+     *  @return  Path and filename.
+     */
+    std::string getPath () const {return path_;}
+
+    /**
+     *  @brief  Gets the error message if loading FAILED.
+     *  @return  Error message.
+     */
+    std::string getError () const
+    {
+        if (getStatus() != FAILED) return "";
+        std::lock_guard<std::mutex> lock (mutex_);
+        return error_;
+    }
+
+    /**
+     *  @brief  Takes over the loaded %Sample.
+     *  @return  Pointer to the %Sample if READY, otherwise nullptr. The
+     *  caller becomes owner of the %Sample.
+     */
+    Sample* release ()
+    {
+        if (getStatus() != READY) return nullptr;
+        if (thread_.joinable()) thread_.join();
+
+        Sample* s = sample_;
+        sample_ = nullptr;
+        status_.store (IDLE);
+        return s;
+    }
+
+    /**
+     *  @brief  Gets info about the %Sample under construction.
+     *  @param info  Reference to take up the sound file info.
+     *  @param frames  Reference to take up the number of frames available
+     *  for @c getPreviewPeak() .
+     *  @return  True if a preview is available, otherwise false.
+     */
+    bool getPreviewInfo (SF_INFO& info, sf_count_t& frames) const
+    {
+        std::lock_guard<std::mutex> lock (mutex_);
+        if (!preview_) return false;
+        info = preview_->info;
+        frames = preview_->peaks->getValidFrames();
+        return true;
+    }
+
+    /**
+     *  @brief  Gets minimum, maximum, and RMS of a frame range of the
+     *  %Sample under construction.
+     *  @param from  First frame.
+     *  @param to  Frame after the last frame.
+     *  @param channel  Channel number.
+     *  @return  Peak data of the loaded part of the frame range.
+     */
+    PeakPyramid::Peak getPreviewPeak (const sf_count_t from, const sf_count_t to, const int channel) const
+    {
+        std::lock_guard<std::mutex> lock (mutex_);
+        if (!preview_) return PeakPyramid::Peak {0.0f, 0.0f, 0.0f};
+        return preview_->getPeak (from, to, channel);
+    }
+
+    /**
+     *  @brief  Gets the absolute maximum of the loaded frames of a channel
+     *  of the %Sample under construction.
+     *  @param channel  Channel number.
+     *  @return  Absolute maximum.
+     */
+    float getPreviewMaxAbs (const int channel) const
+    {
+        std::lock_guard<std::mutex> lock (mutex_);
+        if (!preview_) return 0.0f;
+        return preview_->peaks->getMaxAbs (channel);
+    }
+
+protected:
+
+    void run (const std::string path)
+    {
+        Sample* s = nullptr;
+
+        try
+        {
+            s = new Sample
+            (
+                path.c_str(),
+                [this] (Sample& sample, const sf_count_t frames, const double progress)
+                {
+                    progress_.store (progress);
+                    if (cancel_.load())
+                    {
+                        // Stop preview before the sample is destructed
+                        std::lock_guard<std::mutex> lock (mutex_);
+                        preview_ = nullptr;
+                        return false;
+                    }
+
+                    // Peaks of the loaded frames are available
+                    if ((frames > 0) && (!preview_))
+                    {
+                        std::lock_guard<std::mutex> lock (mutex_);
+                        preview_ = &sample;
+                    }
+                    return true;
+                }
+            );
+        }
+
+        catch (std::exception& exc)
+        {
+            std::lock_guard<std::mutex> lock (mutex_);
+            preview_ = nullptr;
+            error_ = exc.what();
+            status_.store (cancel_.load() ? IDLE : FAILED);
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock (mutex_);
+        preview_ = nullptr;
+        sample_ = s;
+        progress_.store (1.0);
+        status_.store (READY);
+    }
+};
+
+}
+
+#endif /* BMUSIC_SAMPLELOADER_HPP_ */
@@ -0,0 +1,212 @@
+/* SampleStream.hpp
+ * Pattern-controlled audio stream / sample re-sequencer LV2 plugin
+ *
+ * Copyright (C) 2020 - 2022 by Sven Jähnichen
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+#ifndef BMUSIC_SAMPLESTREAM_HPP_
+#define BMUSIC_SAMPLESTREAM_HPP_
+
+#include "sndfile.h"
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#ifndef BMUSIC_DEFAULT_SAMPLESTREAM_BLOCKSIZE
+#define BMUSIC_DEFAULT_SAMPLESTREAM_BLOCKSIZE 16384
+#endif
+
+#ifndef BMUSIC_DEFAULT_SAMPLESTREAM_CACHESIZE
+#define BMUSIC_DEFAULT_SAMPLESTREAM_CACHESIZE 64
+#endif
+
+namespace BMusic
+{
+
+/**
+ *  @brief  Streamed read access to a sound file.
+ *
+ *  %SampleStream decodes blocks of
+ *  @c BMUSIC_DEFAULT_SAMPLESTREAM_BLOCKSIZE frames on demand and keeps the
+ *  last recently used @c BMUSIC_DEFAULT_SAMPLESTREAM_CACHESIZE blocks in a
+ *  cache. Thus, the memory costs are independent of the file size.
+ *
+ *  %SampleStream is thread-safe. But access to blocks not in the cache
+ *  includes file access and thus isn't realtime-safe.
+ */
+class SampleStream
+{
+protected:
+
+    struct Block
+    {
+        sf_count_t index;
+        std::vector<float> data;
+    };
+
+    SNDFILE* sndfile_;
+    SF_INFO info_;
+    std::mutex mutex_;
+    std::list<Block> blocks_;       // Most recently used first
+    std::unordered_map<sf_count_t, std::list<Block>::iterator> index_;
+
+public:
+
+    /**
+     *  @brief  Constructs a %SampleStream from an open sound file.
+     *  @param sndfile  Sound file opened for reading. %SampleStream takes
+     *  over the sound file and closes it upon destruction.
+     *  @param info  Sound file info.
+     */
+    SampleStream (SNDFILE* sndfile, const SF_INFO& info) :
+        sndfile_ (sndfile),
+        info_ (info),
+        mutex_ (),
+        blocks_ (),
+        index_ ()
+    {
+
+    }
+
+    SampleStream (const SampleStream& that) = delete;
+    SampleStream& operator= (const SampleStream& that) = delete;
+
+    ~SampleStream ()
+    {
+        if (sndfile_) sf_close (sndfile_);
+    }
+
+    /**
+     *  @brief  Gets the sound file info.
+     *  @return  Sound file info.
+     */
+    const SF_INFO& getInfo () const {return info_;}
+
+    /**
+     *  @brief  Gets a single sample value.
+     *  @param frame  Frame number.
+     *  @param channel  Channel number.
+     *  @return  Sample value.
+     */
+    float get (const sf_count_t frame, const int channel)
+    {
+        if ((frame < 0) || (frame >= info_.frames) || (channel < 0) || (channel >= info_.channels)) return 0.0f;
+
+        std::lock_guard<std::mutex> lock (mutex_);
+        const Block& b = getBlock (frame / BMUSIC_DEFAULT_SAMPLESTREAM_BLOCKSIZE);
+        return b.data[(frame % BMUSIC_DEFAULT_SAMPLESTREAM_BLOCKSIZE) * info_.channels + channel];
+    }
+
+    /**
+     *  @brief  Copies interleaved frames.
+     *  @param dest  Pointer to the destination buffer. Must be able to take
+     *  up @a frames * channels values.
+     *  @param from  First frame.
+     *  @param frames  Number of frames.
+     *  @return  Number of frames copied.
+     */
+    sf_count_t read (float* dest, const sf_count_t from, const sf_count_t frames)
+    {
+        if ((!dest) || (from < 0) || (from >= info_.frames)) return 0;
+
+        const sf_count_t bs = BMUSIC_DEFAULT_SAMPLESTREAM_BLOCKSIZE;
+        const sf_count_t to = std::min (from + frames, info_.frames);
+        std::lock_guard<std::mutex> lock (mutex_);
+        for (sf_count_t f = from; f < to; )
+        {
+            const Block& b = getBlock (f / bs);
+            const sf_count_t n = std::min (to - f, bs - f % bs);
+            memcpy (dest + (f - from) * info_.channels, b.data.data() + (f % bs) * info_.channels, sizeof (float) * n * info_.channels);
+            f += n;
+        }
+        return to - from;
+    }
+
+    /**
+     *  @brief  Copies the frames of a single channel.
+     *  @param dest  Pointer to the destination buffer. Must be able to take
+     *  up @a frames values.
+     *  @param from  First frame.
+     *  @param frames  Number of frames.
+     *  @param channel  Channel number.
+     *  @return  Number of frames copied.
+     */
+    sf_count_t read (float* dest, const sf_count_t from, const sf_count_t frames, const int channel)
+    {
+        if ((!dest) || (from < 0) || (from >= info_.frames) || (channel < 0) || (channel >= info_.channels)) return 0;
+
+        const sf_count_t bs = BMUSIC_DEFAULT_SAMPLESTREAM_BLOCKSIZE;
+        const sf_count_t to = std::min (from + frames, info_.frames);
+        std::lock_guard<std::mutex> lock (mutex_);
+        for (sf_count_t f = from; f < to; )
+        {
+            const Block& b = getBlock (f / bs);
+            const sf_count_t n = std::min (to - f, bs - f % bs);
+            const float* src = b.data.data() + (f % bs) * info_.channels + channel;
+            float* d = dest + (f - from);
+            for (sf_count_t j = 0; j < n; ++j) d[j] = src[j * info_.channels];
+            f += n;
+        }
+        return to - from;
+    }
+
+protected:
+
+    const Block& getBlock (const sf_count_t index)
+    {
+        // Cached: Move to front
+        std::unordered_map<sf_count_t, std::list<Block>::iterator>::iterator it = index_.find (index);
+        if (it != index_.end())
+        {
+            blocks_.splice (blocks_.begin(), blocks_, it->second);
+            return blocks_.front();
+        }
+
+        // Not cached: Re-use the least recently used block or create a new one
+        if (blocks_.size() >= BMUSIC_DEFAULT_SAMPLESTREAM_CACHESIZE)
+        {
+            index_.erase (blocks_.back().index);
+            blocks_.splice (blocks_.begin(), blocks_, std::prev (blocks_.end()));
+        }
+        else blocks_.push_front (Block {0, std::vector<float> (BMUSIC_DEFAULT_SAMPLESTREAM_BLOCKSIZE * info_.channels)});
+
+        Block& b = blocks_.front();
+        b.index = index;
+        index_[index] = blocks_.begin();
+
+        sf_count_t r = 0;
+        if (sf_seek (sndfile_, index * BMUSIC_DEFAULT_SAMPLESTREAM_BLOCKSIZE, SEEK_SET) >= 0)
+        {
+            while (r < BMUSIC_DEFAULT_SAMPLESTREAM_BLOCKSIZE)
+            {
+                const sf_count_t n = sf_readf_float (sndfile_, b.data.data() + r * info_.channels, BMUSIC_DEFAULT_SAMPLESTREAM_BLOCKSIZE - r);
+                if (n <= 0) break;
+                r += n;
+            }
+        }
+        if (r < BMUSIC_DEFAULT_SAMPLESTREAM_BLOCKSIZE) std::fill (b.data.begin() + r * info_.channels, b.data.end(), 0.0f);
+        return b;
+    }
+};
+
+}
+
+#endif /* BMUSIC_SAMPLESTREAM_HPP_ */
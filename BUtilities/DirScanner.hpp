@@ -0,0 +1,283 @@
+/* DirScanner.hpp
+ * Copyright (C) 2018 - 2022  Sven Jähnichen
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef BUTILITIES_DIRSCANNER_HPP_
+#define BUTILITIES_DIRSCANNER_HPP_
+
+#include <atomic>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <cstring>
+#include <ctime>
+#include <dirent.h>
+#include <sys/stat.h>
+
+#ifndef BUTILITIES_DEFAULT_DIRSCANNER_CACHESIZE
+#define BUTILITIES_DEFAULT_DIRSCANNER_CACHESIZE 16
+#endif
+
+#ifndef BUTILITIES_DEFAULT_DIRSCANNER_BATCHSIZE
+#define BUTILITIES_DEFAULT_DIRSCANNER_BATCHSIZE 256
+#endif
+
+#ifndef PATH_SEPARATOR
+#define PATH_SEPARATOR "/"
+#endif
+
+namespace BUtilities
+{
+
+/**
+ *  @brief  Scans directories in the background.
+ *
+ *  %DirScanner reads the entries of a directory on a worker thread and
+ *  provides them in batches of @c BUTILITIES_DEFAULT_DIRSCANNER_BATCHSIZE
+ *  entries via @c poll() . Hidden entries (starting with ".") are excluded
+ *  except "." and "..". Directories are identified by @c d_type if
+ *  available (no @c stat() call).
+ *
+ *  The listings of the last @c BUTILITIES_DEFAULT_DIRSCANNER_CACHESIZE
+ *  directories are cached together with their modification time (in
+ *  nanosecond resolution). Unchanged directories are provided from the cache
+ *  without scanning.
+ *
+ *  All methods must be called from the same (owner) thread.
+ */
+class DirScanner
+{
+protected:
+
+    struct Listing
+    {
+        struct timespec mtime;
+        std::vector<std::string> dirs;
+        std::vector<std::string> files;
+    };
+
+    std::thread thread_;
+    mutable std::mutex mutex_;
+    std::atomic<bool> cancel_;
+    bool complete_;
+    bool cancelled_;        // Scan cancelled before completion
+    bool delivered_;        // Completion delivered by poll()
+    std::string path_;
+    Listing pending_;       // Entries not yet polled
+    std::map<std::string, Listing> cache_;
+    std::deque<std::string> cacheOrder_;
+
+public:
+
+    /**
+     *  @brief  Constructs an idle %DirScanner.
+     */
+    DirScanner () :
+        thread_ (),
+        mutex_ (),
+        cancel_ (false),
+        complete_ (true),
+        cancelled_ (false),
+        delivered_ (true),
+        path_ (),
+        pending_ (),
+        cache_ (),
+        cacheOrder_ ()
+    {
+
+    }
+
+    DirScanner (const DirScanner& that) = delete;
+    DirScanner& operator= (const DirScanner& that) = delete;
+
+    ~DirScanner ()
+    {
+        cancel ();
+    }
+
+    /**
+     *  @brief  Starts scanning a directory. Cancels a running scan first.
+     *  @param path  Directory path.
+     *
+     *  If the directory is cached and unchanged, all entries are
+     *  immediately available via @c poll() .
+     */
+    void scan (const std::string& path)
+    {
+        cancel ();
+
+        path_ = path;
+        pending_ = Listing ();
+        complete_ = false;
+        cancelled_ = false;
+        delivered_ = false;
+
+        // Use cache if unchanged
+        struct stat sb;
+        if (stat (path.c_str(), &sb) == 0)
+        {
+            std::map<std::string, Listing>::const_iterator it = cache_.find (path);
+            if ((it != cache_.end()) && isSameTime (it->second.mtime, sb.st_mtim))
+            {
+                pending_ = it->second;
+                complete_ = true;
+                return;
+            }
+            pending_.mtime = sb.st_mtim;
+        }
+
+        cancel_.store (false);
+        thread_ = std::thread (&DirScanner::run, this, path);
+    }
+
+    /**
+     *  @brief  Cancels a running scan.
+     *
+     *  A scan cancelled before completion is marked as cancelled and is
+     *  not reported as complete by @c poll() .
+     */
+    void cancel ()
+    {
+        cancel_.store (true);
+        if (thread_.joinable()) thread_.join();
+        if (!complete_) cancelled_ = true;
+    }
+
+    /**
+     *  @brief  Takes over the entries found since the last call.
+     *  @param dirs  Vector to which the new directory names are appended.
+     *  @param files  Vector to which the new file names are appended.
+     *  @return  True if the scan is complete and all entries are taken
+     *  over, otherwise false (also if the scan was cancelled).
+     */
+    bool poll (std::vector<std::string>& dirs, std::vector<std::string>& files)
+    {
+        std::lock_guard<std::mutex> lock (mutex_);
+        dirs.insert (dirs.end(), pending_.dirs.begin(), pending_.dirs.end());
+        files.insert (files.end(), pending_.files.begin(), pending_.files.end());
+        pending_.dirs.clear();
+        pending_.files.clear();
+        delivered_ = complete_;
+        return complete_;
+    }
+
+    /**
+     *  @brief  Checks if entries are available or the scan state changed.
+     *  @return  True if @c poll() would provide new information.
+     */
+    bool isPending () const
+    {
+        std::lock_guard<std::mutex> lock (mutex_);
+        return (!pending_.dirs.empty()) || (!pending_.files.empty()) || (complete_ && (!delivered_));
+    }
+
+    /**
+     *  @brief  Checks if the last scan was cancelled before completion.
+     *  @return  True if cancelled, otherwise false.
+     */
+    bool isCancelled () const {return cancelled_;}
+
+    /**
+     *  @brief  Gets the path of the directory scanned (or to be scanned).
+     *  @return  Directory path.
+     */
+    std::string getPath () const {return path_;}
+
+protected:
+
+    static bool isSameTime (const struct timespec& t1, const struct timespec& t2)
+    {
+        return (t1.tv_sec == t2.tv_sec) && (t1.tv_nsec == t2.tv_nsec);
+    }
+
+    static bool isDir (const std::string& path, const struct dirent* entry)
+    {
+#ifdef _DIRENT_HAVE_D_TYPE
+        if (entry->d_type == DT_DIR) return true;
+        if ((entry->d_type != DT_UNKNOWN) && (entry->d_type != DT_LNK)) return false;
+#endif
+        // Fallback (and symbolic links)
+        const std::string full = (path == PATH_SEPARATOR ? path : path + PATH_SEPARATOR) + entry->d_name;
+        struct stat sb;
+        if (stat (full.c_str(), &sb)) return false;
+        return S_ISDIR (sb.st_mode);
+    }
+
+    void run (const std::string path)
+    {
+        Listing listing;
+        {
+            std::lock_guard<std::mutex> lock (mutex_);
+            listing.mtime = pending_.mtime;
+        }
+
+        DIR* dir = opendir (path.c_str());
+        if (dir)
+        {
+            Listing batch;
+            for (struct dirent* entry = readdir (dir); entry && (!cancel_.load()); entry = readdir (dir))
+            {
+                const char* name = entry->d_name;
+                const bool hidden = (name[0] == '.');
+
+                if (isDir (path, entry))
+                {
+                    // Exclude hidden, but keep "." and ".."
+                    if ((!hidden) || (!strcmp (name, ".")) || (!strcmp (name, ".."))) batch.dirs.push_back (name);
+                }
+                else if (!hidden) batch.files.push_back (name);
+
+                if (batch.dirs.size() + batch.files.size() >= BUTILITIES_DEFAULT_DIRSCANNER_BATCHSIZE) publish (batch, listing);
+            }
+            closedir (dir);
+            publish (batch, listing);
+        }
+
+        std::lock_guard<std::mutex> lock (mutex_);
+        if (!cancel_.load())
+        {
+            // Cache listing
+            if (cache_.find (path) == cache_.end()) cacheOrder_.push_back (path);
+            cache_[path] = listing;
+            while (cacheOrder_.size() > BUTILITIES_DEFAULT_DIRSCANNER_CACHESIZE)
+            {
+                cache_.erase (cacheOrder_.front());
+                cacheOrder_.pop_front();
+            }
+
+            complete_ = true;
+        }
+    }
+
+    void publish (Listing& batch, Listing& listing)
+    {
+        listing.dirs.insert (listing.dirs.end(), batch.dirs.begin(), batch.dirs.end());
+        listing.files.insert (listing.files.end(), batch.files.begin(), batch.files.end());
+
+        std::lock_guard<std::mutex> lock (mutex_);
+        pending_.dirs.insert (pending_.dirs.end(), batch.dirs.begin(), batch.dirs.end());
+        pending_.files.insert (pending_.files.end(), batch.files.begin(), batch.files.end());
+        batch.dirs.clear();
+        batch.files.clear();
+    }
+};
+
+}
+
+#endif /* BUTILITIES_DIRSCANNER_HPP_ */
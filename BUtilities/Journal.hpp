@@ -0,0 +1,259 @@
+/* Journal.hpp
+ * Copyright (C) 2018 - 2022  Sven Jähnichen
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef BUTILITIES_JOURNAL_HPP_
+#define BUTILITIES_JOURNAL_HPP_
+
+#include <cstddef>
+#include <deque>
+#include <map>
+#include <utility>
+#include <vector>
+
+#ifndef BUTILITIES_DEFAULT_JOURNAL_SIZE
+#define BUTILITIES_DEFAULT_JOURNAL_SIZE 65536
+#endif
+
+namespace BUtilities
+{
+
+/**
+ *  @brief  Undo / redo journal of value changes.
+ *  @tparam K  Key type (e.g., index of a changed element). Must support
+ *  @c operator< .
+ *  @tparam V  Value type. Must support @c operator== .
+ *
+ *  %Journal stores actions. Each action is a list of changes (key, value
+ *  before, value after). Only the changed elements are stored, not the
+ *  whole data. Changes added between @c begin() and @c end() form a
+ *  single action (e.g., a drag stroke). Multiple changes of the same key
+ *  within an action are coalesced into one change. Changes added outside
+ *  of @c begin() and @c end() form an action on their own.
+ *
+ *  The total number of changes stored is limited by the maximum size. If
+ *  a new action exceeds this limit, the oldest actions are dropped.
+ */
+template <class K, class V>
+class Journal
+{
+public:
+
+    /**
+     *  @brief  Single change of a value.
+     */
+    struct Change
+    {
+        K key;
+        V from;
+        V to;
+    };
+
+    typedef std::vector<Change> Action;
+
+protected:
+    std::deque<Action> actions_;
+    size_t position_;           // Number of actions which can be undone
+    size_t size_;               // Total number of changes stored
+    size_t maxSize_;
+    int depth_;
+    Action open_;
+    std::map<K, size_t> openIndex_;
+
+public:
+
+    /**
+     *  @brief  Constructs an empty %Journal.
+     *  @param maxSize  Optional, maximum total number of changes to be
+     *  stored.
+     */
+    Journal (const size_t maxSize = BUTILITIES_DEFAULT_JOURNAL_SIZE) :
+        actions_ (),
+        position_ (0),
+        size_ (0),
+        maxSize_ (maxSize),
+        depth_ (0),
+        open_ (),
+        openIndex_ ()
+    {
+
+    }
+
+    /**
+     *  @brief  Opens an action. Calls may be nested.
+     */
+    void begin () {++depth_;}
+
+    /**
+     *  @brief  Closes an action. The action is stored if the outermost
+     *  action is closed and if it contains changes.
+     */
+    void end ()
+    {
+        if (depth_ > 0) --depth_;
+        if (depth_ == 0) commit ();
+    }
+
+    /**
+     *  @brief  Checks if an action is open.
+     *  @return  True if open, otherwise false.
+     */
+    bool isOpen () const {return (depth_ > 0);}
+
+    /**
+     *  @brief  Adds a change.
+     *  @param key  Key of the changed element.
+     *  @param from  Value before the change.
+     *  @param to  Value after the change.
+     */
+    void add (const K& key, const V& from, const V& to)
+    {
+        typename std::map<K, size_t>::const_iterator it = openIndex_.find (key);
+        if (it != openIndex_.end()) open_[it->second].to = to;
+        else
+        {
+            openIndex_[key] = open_.size();
+            open_.push_back (Change {key, from, to});
+        }
+
+        if (depth_ == 0) commit ();
+    }
+
+    /**
+     *  @brief  Checks if an action can be undone.
+     *  @return  True if possible, otherwise false.
+     */
+    bool canUndo () const {return (depth_ == 0) && (position_ > 0);}
+
+    /**
+     *  @brief  Checks if an action can be redone.
+     *  @return  True if possible, otherwise false.
+     */
+    bool canRedo () const {return (depth_ == 0) && (position_ < actions_.size());}
+
+    /**
+     *  @brief  Steps back one action.
+     *  @return  Action to be undone. Its changes have to be reverted in
+     *  reverse order by setting the @c from values. Empty if nothing can be
+     *  undone.
+     */
+    Action undo ()
+    {
+        if (!canUndo ()) return Action ();
+        --position_;
+        return actions_[position_];
+    }
+
+    /**
+     *  @brief  Steps forward one action.
+     *  @return  Action to be redone. Its changes have to be applied in
+     *  order by setting the @c to values. Empty if nothing can be redone.
+     */
+    Action redo ()
+    {
+        if (!canRedo ()) return Action ();
+        ++position_;
+        return actions_[position_ - 1];
+    }
+
+    /**
+     *  @brief  Removes all actions.
+     */
+    void clear ()
+    {
+        actions_.clear();
+        position_ = 0;
+        size_ = 0;
+        open_.clear();
+        openIndex_.clear();
+    }
+
+    /**
+     *  @brief  Sets the maximum total number of changes to be stored.
+     *  @param maxSize  Maximum number of changes.
+     *
+     *  If the journal exceeds the new limit, redo actions are dropped first,
+     *  then the oldest actions.
+     */
+    void setMaxSize (const size_t maxSize)
+    {
+        maxSize_ = maxSize;
+        limit ();
+    }
+
+    /**
+     *  @brief  Gets the maximum total number of changes to be stored.
+     *  @return  Maximum number of changes.
+     */
+    size_t getMaxSize () const {return maxSize_;}
+
+    /**
+     *  @brief  Gets the total number of changes stored.
+     *  @return  Number of changes.
+     */
+    size_t getSize () const {return size_;}
+
+protected:
+
+    void commit ()
+    {
+        openIndex_.clear();
+
+        // Remove changes without effect
+        Action action;
+        action.reserve (open_.size());
+        for (const Change& c : open_)
+        {
+            if (!(c.from == c.to)) action.push_back (c);
+        }
+        open_.clear();
+        if (action.empty()) return;
+
+        // Drop redo actions
+        while (actions_.size() > position_)
+        {
+            size_ -= actions_.back().size();
+            actions_.pop_back();
+        }
+
+        size_ += action.size();
+        actions_.push_back (std::move (action));
+        position_ = actions_.size();
+        limit ();
+    }
+
+    void limit ()
+    {
+        // Drop redo actions first (newest first)
+        while ((size_ > maxSize_) && (actions_.size() > position_))
+        {
+            size_ -= actions_.back().size();
+            actions_.pop_back();
+        }
+
+        // Then drop the oldest undo actions
+        while ((size_ > maxSize_) && (!actions_.empty()))
+        {
+            size_ -= actions_.front().size();
+            actions_.pop_front();
+            if (position_ > 0) --position_;
+        }
+    }
+};
+
+}
+
+#endif /* BUTILITIES_JOURNAL_HPP_ */
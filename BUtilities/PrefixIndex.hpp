@@ -0,0 +1,136 @@
+/* PrefixIndex.hpp
+ * Copyright (C) 2018 - 2022  Sven Jähnichen
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef BUTILITIES_PREFIXINDEX_HPP_
+#define BUTILITIES_PREFIXINDEX_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace BUtilities
+{
+
+/**
+ *  @brief  Sorted index for case-insensitive prefix search.
+ *
+ *  %PrefixIndex stores pairs of a text and an ID, sorted by the text with
+ *  ASCII characters folded to lower case. All entries starting with a
+ *  prefix form a contiguous range which is found by binary search in
+ *  O(log n). Entries are added by @c add() and become searchable after
+ *  @c build() .
+ */
+class PrefixIndex
+{
+public:
+
+    typedef std::pair<std::string, size_t> Entry;
+    typedef std::vector<Entry>::const_iterator const_iterator;
+
+protected:
+    std::vector<Entry> entries_;
+
+public:
+
+    /**
+     *  @brief  Constructs an empty %PrefixIndex.
+     */
+    PrefixIndex () : entries_ () {}
+
+    /**
+     *  @brief  Removes all entries.
+     */
+    void clear () {entries_.clear();}
+
+    /**
+     *  @brief  Reserves memory for entries.
+     *  @param size  Number of entries.
+     */
+    void reserve (const size_t size) {entries_.reserve (size);}
+
+    /**
+     *  @brief  Adds an entry. Requires a call of @c build() before search.
+     *  @param text  Text.
+     *  @param id  ID (e.g., position of the text in a list).
+     */
+    void add (const std::string& text, const size_t id)
+    {
+        entries_.emplace_back (fold (text), id);
+    }
+
+    /**
+     *  @brief  Sorts the entries.
+     */
+    void build ()
+    {
+        std::sort (entries_.begin(), entries_.end());
+    }
+
+    /**
+     *  @brief  Gets the number of entries.
+     *  @return  Number of entries.
+     */
+    size_t size () const {return entries_.size();}
+
+    /**
+     *  @brief  Finds all entries starting with a prefix.
+     *  @param prefix  Prefix (case-insensitive for ASCII characters).
+     *  @return  Range of the matching entries, sorted by the folded text.
+     */
+    std::pair<const_iterator, const_iterator> find (const std::string& prefix) const
+    {
+        const std::string p = fold (prefix);
+        const_iterator first = std::lower_bound
+        (
+            entries_.begin(),
+            entries_.end(),
+            p,
+            [] (const Entry& e, const std::string& s) {return e.first < s;}
+        );
+
+        const_iterator last = std::upper_bound
+        (
+            first,
+            entries_.end(),
+            p,
+            [] (const std::string& s, const Entry& e) {return e.first.compare (0, s.size(), s) > 0;}
+        );
+
+        return std::make_pair (first, last);
+    }
+
+    /**
+     *  @brief  Folds ASCII characters to lower case.
+     *  @param text  Text.
+     *  @return  Folded text.
+     */
+    static std::string fold (const std::string& text)
+    {
+        std::string s = text;
+        for (char& c : s)
+        {
+            if ((c >= 'A') && (c <= 'Z')) c = c - 'A' + 'a';
+        }
+        return s;
+    }
+};
+
+}
+
+#endif /* BUTILITIES_PREFIXINDEX_HPP_ */
@@ -0,0 +1,104 @@
+/* RingBuffer.hpp
+ * Copyright (C) 2018 - 2022  Sven Jähnichen
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef BUTILITIES_RINGBUFFER_HPP_
+#define BUTILITIES_RINGBUFFER_HPP_
+
+#include <atomic>
+#include <array>
+#include <cstddef>
+
+namespace BUtilities
+{
+
+/**
+ *  @brief  Lock-free single producer / single consumer ring buffer.
+ *  @tparam T  Element type.
+ *  @tparam N  Capacity. Must be a power of two.
+ *
+ *  %RingBuffer can be written by exactly one thread (e.g., a realtime
+ *  audio thread) and read by exactly one other thread (e.g., the GUI
+ *  thread) without locks or memory allocation.
+ */
+template <class T, size_t N>
+class RingBuffer
+{
+    static_assert ((N >= 2) && ((N & (N - 1)) == 0), "RingBuffer size must be a power of two");
+
+protected:
+    std::array<T, N> data_;
+    std::atomic<size_t> writePos_;
+    std::atomic<size_t> readPos_;
+
+public:
+
+    /**
+     *  @brief  Constructs an empty %RingBuffer.
+     */
+    RingBuffer () : data_ (), writePos_ (0), readPos_ (0) {}
+
+    RingBuffer (const RingBuffer& that) = delete;
+    RingBuffer& operator= (const RingBuffer& that) = delete;
+
+    /**
+     *  @brief  Writes an element to the %RingBuffer. Producer thread only.
+     *  @param value  Element.
+     *  @return  True on success, false if the %RingBuffer is full.
+     */
+    bool push (const T& value)
+    {
+        const size_t w = writePos_.load (std::memory_order_relaxed);
+        if (w - readPos_.load (std::memory_order_acquire) >= N) return false;
+        data_[w & (N - 1)] = value;
+        writePos_.store (w + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     *  @brief  Reads and removes the oldest element from the %RingBuffer.
+     *  Consumer thread only.
+     *  @param value  Reference to take up the element.
+     *  @return  True on success, false if the %RingBuffer is empty.
+     */
+    bool pop (T& value)
+    {
+        const size_t r = readPos_.load (std::memory_order_relaxed);
+        if (r == writePos_.load (std::memory_order_acquire)) return false;
+        value = data_[r & (N - 1)];
+        readPos_.store (r + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     *  @brief  Checks if the %RingBuffer is empty.
+     *  @return  True if empty, otherwise false.
+     */
+    bool empty () const
+    {
+        return (readPos_.load (std::memory_order_acquire) == writePos_.load (std::memory_order_acquire));
+    }
+
+    /**
+     *  @brief  Gets the capacity of the %RingBuffer.
+     *  @return  Capacity.
+     */
+    static constexpr size_t capacity () {return N;}
+};
+
+}
+
+#endif /* BUTILITIES_RINGBUFFER_HPP_ */
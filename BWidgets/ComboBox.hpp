@@ -148,6 +148,14 @@ public:
      */
     virtual void setValue (const size_t& value) override;
 
+	/**
+     *  @brief  Changes the value.
+     *  @param value  Value.
+     *
+     *  Equivalent to @c setValue(const size_t&) .
+     */
+    virtual void setValue (size_t&& value) override;
+
 	/**
      *  @brief  Changes the value if the item text is part of the items.
      *  @param item  Item text.
@@ -262,7 +270,6 @@ inline ComboBox::ComboBox	(const double x, const double y, const double width, c
 								 BUtilities::Urid::urid (BUtilities::Urid::uri (urid) + "/button"), "");
 	button_->setCallbackFunction(BEvents::Event::VALUE_CHANGED_EVENT, ComboBox::buttonChangedCallback);
 	add (button_);
-	for (Widget* w : items_) w->setHeight (itemHeight_);
 }
 
 inline ComboBox::~ComboBox()
@@ -280,12 +287,16 @@ inline Widget* ComboBox::clone () const
 inline void ComboBox::copy (const ComboBox* that)
 {
 	if (listBox_) delete listBox_;
-	listBox_ = that->listBox_->clone();
+	listBox_ = (that->listBox_ ? that->listBox_->clone() : nullptr);
 	if (listBox_) add (listBox_);
 
 	listBoxArea_ = that->listBoxArea_;
 
 	SpinBox::copy (that);
+
+	// Show own items
+	ListBox* l = dynamic_cast<ListBox*>(listBox_);
+	if (l) l->setItemSource (source_);
 }
 
 inline void ComboBox::setValue (const size_t& value)
@@ -301,6 +312,11 @@ inline void ComboBox::setValue (const size_t& value)
 	SpinBox::setValue (value);
 }
 
+inline void ComboBox::setValue (size_t&& value)
+{
+	setValue (static_cast<const size_t&> (value));
+}
+
 inline void ComboBox::setValue (const std::string& item)
 {
 	SpinBox::setValue (item);
@@ -354,17 +370,7 @@ inline void ComboBox::showListbox()
 	ListBox* l = dynamic_cast<ListBox*>(listBox_);
 	if (l)
 	{
-		if (!items_.empty())
-		{
-			for (std::list<Widget*>::iterator it = std::next (items_.begin()); it != items_.end(); ++it)
-			{
-				Label* wl = dynamic_cast<Label*>(*it);
-				if (wl)
-				{
-					l->addItem (wl->getText());
-				}
-			}
-		}
+		l->setItemSource (source_);	// Share items, no copy
 		l->setCallbackFunction(BEvents::Event::VALUE_CHANGED_EVENT, ComboBox::listBoxChangedCallback);
 		l->setStacking (STACKING_ESCAPE);
 		l->setValue (getValue());
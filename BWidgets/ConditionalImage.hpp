@@ -21,6 +21,7 @@
 #include "Widget.hpp"
 #include "Label.hpp"
 #include <algorithm>
+#include <map>
 #include <cairo/cairo.h>
 #include "Supports/Validatable.hpp"
 #include "Supports/ValueableTyped.hpp"
@@ -443,7 +444,7 @@ inline bool ConditionalImage::isClosestToValue (ConditionalImage* widget, const
 	if (widget->imageSurfaces_.empty()) return false;
 
 	// No image for this value: false
-	map<double, cairo_surface_t*>::const_iterator it = widget->imageSurfaces_.find (value);
+	std::map<double, cairo_surface_t*>::const_iterator it = widget->imageSurfaces_.find (value);
 	if (it == widget->imageSurfaces_.end()) return false;
 
 	// Only one image: always the closest
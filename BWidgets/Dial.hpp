@@ -65,6 +65,9 @@ class Dial :	public RadialMeter,
 				public Draggable, 
 				public Scrollable
 {
+protected:
+	BStyles::Color staticFgColor_;
+
 public:
 
 	/**
@@ -171,6 +174,17 @@ public:
 
 protected:
 	/**
+	 *  @brief  Renders the static elements of the %Dial to the static
+	 *  surface.
+	 *  @param step  Relative size of each segment (not used).
+	 *  @param bgColor  Bar RGBA color.
+	 *
+	 *  In addition to the arc body, the static surface of a %Dial also
+	 *  contains the central knob. Also re-rendered if the FgColors changed.
+	 */
+	virtual void drawStatic (const double step, const BStyles::Color& bgColor) override;
+
+	/**
      *  @brief  Unclipped draw a %Dial to the surface.
      */
     virtual void draw () override;
@@ -226,7 +240,8 @@ inline Dial::Dial	(const double  x, const double y, const double width, const do
 		RadialMeter	(x, y, width, height, value, min, max, step, transferFunc, reTransferFunc, urid, title),
 		Clickable(),
 		Draggable(),
-		Scrollable()
+		Scrollable(),
+		staticFgColor_ ()
 {
 
 }
@@ -319,6 +334,38 @@ inline void Dial::onWheelScrolled (BEvents::Event* event)
 	Scrollable::onWheelScrolled (event);
 }
 
+inline void Dial::drawStatic (const double step, const BStyles::Color& bgColor)
+{
+	const BStyles::Color fgColor = getFgColors()[getStatus()];
+
+	if
+	(
+		staticSurface_ &&
+		(cairo_image_surface_get_width (staticSurface_) == cairo_image_surface_get_width (surface_)) &&
+		(cairo_image_surface_get_height (staticSurface_) == cairo_image_surface_get_height (surface_)) &&
+		(staticScale_ == scale_) &&
+		(staticBgColor_ == bgColor) &&
+		(staticFgColor_ == fgColor)
+	) return;
+
+	if (staticSurface_) cairo_surface_destroy (staticSurface_);
+	staticSurface_ = cairo_image_surface_create (CAIRO_FORMAT_ARGB32, getWidth(), getHeight());
+	staticScale_ = scale_;
+	staticStep_ = step;
+	staticBgColor_ = bgColor;
+	staticFgColor_ = fgColor;
+
+	if (cairo_surface_status (staticSurface_) != CAIRO_STATUS_SUCCESS) return;
+	cairo_t* cr = cairo_create (staticSurface_);
+	if (cairo_status (cr) == CAIRO_STATUS_SUCCESS)
+	{
+		const double rad = 0.5 * (scale_.getWidth() < scale_.getHeight() ? scale_.getWidth() : scale_.getHeight());
+		drawArcStatic (cr, scale_.getX() + 0.5 * scale_.getWidth(), scale_.getY() + 0.5 * scale_.getHeight(), rad - 1.0, fgColor, bgColor);
+		drawKnob(cr, scale_.getX() + 0.5 * scale_.getWidth() + 0.5, scale_.getY() + 0.5 * scale_.getHeight() + 0.5, 0.6 * rad - 1.0, 1.0, bgColor, bgColor);
+	}
+	cairo_destroy (cr);
+}
+
 inline void Dial::draw ()
 {
 	draw (0, 0, getWidth(), getHeight());
@@ -352,17 +399,24 @@ inline void Dial::draw (const BUtilities::Area<>& area)
 			const BStyles::Color fgColor = getFgColors()[getStatus()];
 			const BStyles::Color bgColor = getBgColors()[getStatus()];
 
+			// Blit static elements
+			drawStatic (0.0, bgColor);
+			if (staticSurface_ && (cairo_surface_status (staticSurface_) == CAIRO_STATUS_SUCCESS))
+			{
+				cairo_set_source_surface (cr, staticSurface_, 0, 0);
+				cairo_paint (cr);
+			}
+
+			// Draw active elements
 			if (step_ >= 0.0)
 			{
-				drawArc (cr, scale_.getX() + 0.5 * scale_.getWidth(), scale_.getY() + 0.5 * scale_.getHeight(), rad - 1.0, 0.0, rval, fgColor, bgColor);
-				drawKnob(cr, scale_.getX() + 0.5 * scale_.getWidth() + 0.5, scale_.getY() + 0.5 * scale_.getHeight() + 0.5, 0.6 * rad - 1.0, 1.0, bgColor, bgColor);
+				drawArcActive (cr, scale_.getX() + 0.5 * scale_.getWidth(), scale_.getY() + 0.5 * scale_.getHeight(), rad - 1.0, 0.0, rval, fgColor, bgColor);
 				drawArcHandle (cr, scale_.getX() + 0.5 * scale_.getWidth(), scale_.getY() + 0.5 * scale_.getHeight(), rad - 1.0, rval, fgColor, bgColor);
 			}
 
 			else
 			{
-				drawArc (cr, scale_.getX() + 0.5 * scale_.getWidth(), scale_.getY() + 0.5 * scale_.getHeight(), rad - 1.0, 1.0 - rval, 1.0, fgColor, bgColor);
-				drawKnob(cr, scale_.getX() + 0.5 * scale_.getWidth() + 0.5, scale_.getY() + 0.5 * scale_.getHeight() + 0.5, 0.6 * rad - 1.0, 1.0, bgColor, bgColor);
+				drawArcActive (cr, scale_.getX() + 0.5 * scale_.getWidth(), scale_.getY() + 0.5 * scale_.getHeight(), rad - 1.0, 1.0 - rval, 1.0, fgColor, bgColor);
 				drawArcHandle (cr, scale_.getX() + 0.5 * scale_.getWidth(), scale_.getY() + 0.5 * scale_.getHeight(), rad - 1.0, 1.0 - rval, fgColor, bgColor);
 			}
 		}
@@ -36,28 +36,25 @@
 #endif
 
 /**
- *  @brief  Draws a pseudo 3d arc in a Cairo context. 
+ *  @brief  Draws the static (value-independent) elements of a pseudo 3d arc
+ *  in a Cairo context. 
  *  @param cr  Cairo context.
  *  @param xc  X center position.
  *  @param y0  Y center position.
  *  @param radius  Arc radius.
- *  @param min  Start of activated (highlighted) part of the arc. Relative
- *  value [0..1].
- *  @param max  End of activated (highlighted) part of the arc. Relative
- *  value [0..1].
  *  @param fgColor  RGBA color for the activated part.
  *  @param bgColor  Bar RGBA color.
+ *
+ *  Draws the arc body and its illumination. The result only depends on the
+ *  geometry and the colors and thus may be cached and blitted before 
+ *  calling @c drawArcActive() .
  */
-inline void drawArc     (cairo_t* cr, const double xc, const double yc, const double radius,
-                         const double min, const double max, 
-                         const BStyles::Color fgColor, const BStyles::Color bgColor)
+inline void drawArcStatic   (cairo_t* cr, const double xc, const double yc, const double radius,
+                             const BStyles::Color fgColor, const BStyles::Color bgColor)
 {
     cairo_set_line_width (cr, 0.0);
     
     // Colors used
-    const BStyles::Color fgHi = fgColor.illuminate (BStyles::Color::illuminated);
-    //const BStyles::Color fgMid = fgColor.illuminate (0.5 * BStyles::Color::illuminated);
-    const BStyles::Color fgLo = fgColor;
     //const BStyles::Color bgLo = bgColor;
     const BStyles::Color bgHi = bgColor.illuminate (BStyles::Color::illuminated);
     const BStyles::Color bgSh = bgColor.illuminate (BStyles::Color::shadowed);
@@ -96,9 +93,39 @@ inline void drawArc     (cairo_t* cr, const double xc, const double yc, const do
         cairo_fill (cr);
         cairo_pattern_destroy (pat);
     }
+}
+
+/**
+ *  @brief  Draws the active (value-dependent) elements of a pseudo 3d arc 
+ *  in a Cairo context. 
+ *  @param cr  Cairo context.
+ *  @param xc  X center position.
+ *  @param y0  Y center position.
+ *  @param radius  Arc radius.
+ *  @param min  Start of activated (highlighted) part of the arc. Relative
+ *  value [0..1].
+ *  @param max  End of activated (highlighted) part of the arc. Relative
+ *  value [0..1].
+ *  @param fgColor  RGBA color for the activated part.
+ *  @param bgColor  Bar RGBA color.
+ *
+ *  Draws the activated part and the arc edges on top of the elements drawn
+ *  by @c drawArcStatic() .
+ */
+inline void drawArcActive   (cairo_t* cr, const double xc, const double yc, const double radius,
+                             const double min, const double max, 
+                             const BStyles::Color fgColor, const BStyles::Color bgColor)
+{
+    // Colors used
+    const BStyles::Color fgHi = fgColor.illuminate (BStyles::Color::illuminated);
+    const BStyles::Color fgLo = fgColor;
+    const BStyles::Color bgHi = bgColor.illuminate (BStyles::Color::illuminated);
+    const BStyles::Color bgSh = bgColor.illuminate (BStyles::Color::shadowed);
+
+    cairo_set_line_width (cr, 0.0);
 
     // Fill
-    pat = cairo_pattern_create_linear (xc - radius, yc - radius, xc + radius, yc + radius);
+    cairo_pattern_t* pat = cairo_pattern_create_linear (xc - radius, yc - radius, xc + radius, yc + radius);
     if (pat && (cairo_pattern_status (pat) == CAIRO_STATUS_SUCCESS))
     {
         cairo_pattern_add_color_stop_rgba (pat, 0.0, CAIRO_RGBA(fgHi));
@@ -111,9 +138,7 @@ inline void drawArc     (cairo_t* cr, const double xc, const double yc, const do
         cairo_pattern_destroy (pat);
     }
 
-
     // Edges of the arc
-
     pat = cairo_pattern_create_linear (xc + radius, yc + radius, xc - radius, yc - radius);
     if (pat && (cairo_pattern_status (pat) == CAIRO_STATUS_SUCCESS))
     {
@@ -143,4 +168,25 @@ inline void drawArc     (cairo_t* cr, const double xc, const double yc, const do
     }
 }
 
+/**
+ *  @brief  Draws a pseudo 3d arc in a Cairo context. 
+ *  @param cr  Cairo context.
+ *  @param xc  X center position.
+ *  @param y0  Y center position.
+ *  @param radius  Arc radius.
+ *  @param min  Start of activated (highlighted) part of the arc. Relative
+ *  value [0..1].
+ *  @param max  End of activated (highlighted) part of the arc. Relative
+ *  value [0..1].
+ *  @param fgColor  RGBA color for the activated part.
+ *  @param bgColor  Bar RGBA color.
+ */
+inline void drawArc     (cairo_t* cr, const double xc, const double yc, const double radius,
+                         const double min, const double max, 
+                         const BStyles::Color fgColor, const BStyles::Color bgColor)
+{
+    drawArcStatic (cr, xc, yc, radius, fgColor, bgColor);
+    drawArcActive (cr, xc, yc, radius, min, max, fgColor, bgColor);
+}
+
 #endif /*  BWIDGETS_DRAWARC_HPP_ */
\ No newline at end of file
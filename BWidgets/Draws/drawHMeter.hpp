@@ -22,36 +22,28 @@
 #include <cmath>
 #include <functional>
 #include "../../BStyles/Types/Color.hpp"
+#include "meterSegmentColors.hpp"
 
 /**
- *  @brief  Draws a segmented two colors horizontal pseudo 3d bar in a Cairo
- *  context. 
+ *  @brief  Draws the static (value-independent) elements of a segmented
+ *  horizontal pseudo 3d bar in a Cairo context. 
  *  @param cr  Cairo context.
  *  @param x0  X position.
  *  @param y0  Y position.
  *  @param width  Bar width.
  *  @param height  Bar height.
- *  @param min  Start of activated (highlighted) part of the arc. Relative
- *  value [0..1].
- *  @param max  End of activated (highlighted) part of the arc. Relative
- *  value [0..1].
  *  @param step  Size of each segment.
- *  @param loColor  RGBA color for the low values of the activated part.
- *  @param hiColor  RGBA color for the high values of the activated part.
- *  @param gradient  Color gradient function.
  *  @param bgColor  Bar RGBA color.
+ *
+ *  Draws the background, the border, and all segments in their inactive
+ *  state. The result only depends on the geometry, @a step and @a bgColor
+ *  and thus may be cached and blitted before calling @c drawHMeterActive() .
  */
-inline void drawHMeter    (cairo_t* cr, const double x0, const double y0, const double width, const double height, 
-                             const double min, const double max, const double step,
-                             const BStyles::Color loColor, const BStyles::Color hiColor, std::function<double(const double &)> gradient, 
-                             const BStyles::Color bgColor)
+inline void drawHMeterStatic  (cairo_t* cr, const double x0, const double y0, const double width, const double height, 
+                             const double step, const BStyles::Color bgColor)
 {
 
     const double dx = (width - 0.2 * height) * step;
-    const BStyles::Color fgHi = loColor.illuminate (BStyles::Color::illuminated);
-    const BStyles::Color fgLo = loColor;
-    const BStyles::Color hiHi = hiColor.illuminate (BStyles::Color::illuminated);
-    const BStyles::Color hiLo = hiColor;
     const BStyles::Color bgLo = bgColor.illuminate (BStyles::Color::shadowed);
     const BStyles::Color bgHi = bgColor;
     const BStyles::Color bgDk = bgColor.illuminate (-0.75);
@@ -75,62 +67,145 @@ inline void drawHMeter    (cairo_t* cr, const double x0, const double y0, const
         cairo_pattern_destroy (pat);
     }
 
-    // Fill
+    // Inactive segments
     cairo_set_line_width (cr, 0.0);
-    cairo_pattern_t* fgPat = cairo_pattern_create_linear (x0, y0, x0 + width, y0 + height);
     cairo_pattern_t* bgPat = cairo_pattern_create_linear (x0, y0, x0 + width, y0 + height);
-    if (fgPat && bgPat && (cairo_pattern_status (fgPat) == CAIRO_STATUS_SUCCESS) && (cairo_pattern_status (bgPat) == CAIRO_STATUS_SUCCESS))
+    if (bgPat && (cairo_pattern_status (bgPat) == CAIRO_STATUS_SUCCESS))
     {
-        cairo_pattern_add_color_stop_rgba (fgPat, 0, CAIRO_RGBA(fgLo));
-        cairo_pattern_add_color_stop_rgba (fgPat, 0.25, CAIRO_RGBA(fgHi));
-        cairo_pattern_add_color_stop_rgba (fgPat, 1, CAIRO_RGBA(fgLo));
         cairo_pattern_add_color_stop_rgba (bgPat, 0, CAIRO_RGBA(bgLo));
         cairo_pattern_add_color_stop_rgba (bgPat, 0.25, CAIRO_RGBA(bgHi));
         cairo_pattern_add_color_stop_rgba (bgPat, 1, CAIRO_RGBA(bgLo));
+        cairo_set_source (cr, bgPat);
 
         for (double v = 0; v < 1.0; v += step)
         {
-            if ((v >= min) && (v <= max)) 
-            {
-                if ((fgHi != hiHi) || (fgLo != hiLo))
-                {
-                    fgPat = cairo_pattern_create_linear (x0, y0, x0 + width, y0 + height);
-                    BStyles::Color cLo; 
-                    cLo.setHSV
-                    (
-                        fgLo.hue() * (1.0 - gradient (v)) + hiLo.hue() * gradient (v),
-                        fgLo.saturation() * (1.0 - gradient (v)) + hiLo.saturation() * gradient (v),
-                        fgLo.value() * (1.0 - gradient (v)) + hiLo.value() * gradient (v),
-                        fgLo.alpha * (1.0 - gradient (v)) + hiLo.alpha * gradient (v)
-                    );
-                    BStyles::Color cHi;
-                    cHi.setHSV
-                    (
-                        fgHi.hue() * (1.0 - gradient (v)) + hiHi.hue() * gradient (v),
-                        fgHi.saturation() * (1.0 - gradient (v)) + hiHi.saturation() * gradient (v),
-                        fgHi.value() * (1.0 - gradient (v)) + hiHi.value() * gradient (v),
-                        fgHi.alpha * (1.0 - gradient (v)) + hiHi.alpha * gradient (v)
-                    );
-
-                    cairo_pattern_add_color_stop_rgba (fgPat, 0, CAIRO_RGBA(cLo));
-                    cairo_pattern_add_color_stop_rgba (fgPat, 0.25, CAIRO_RGBA(cHi));
-                    cairo_pattern_add_color_stop_rgba (fgPat, 1, CAIRO_RGBA(cLo));
-                }
-                cairo_set_source (cr, fgPat);
-            }
-
-            else cairo_set_source (cr, bgPat);
-
             const double x = v * (width - 0.2 * height);
 
             if (dx < 3.0) cairo_rectangle (cr, x0 + 0.1 * height + x, y0 + 0.1 * height, dx, height - 0.2 * height);
             else cairo_rectangle (cr, x0 + 0.1 * height + x + 1.0, y0 + 0.1 * height, dx - 2.0, height - 0.2 * height);
-            cairo_fill (cr);
         }
+        cairo_fill (cr);
 
         cairo_pattern_destroy (bgPat);
-        cairo_pattern_destroy (fgPat);
     }
 }
 
+/**
+ *  @brief  Draws the active (value-dependent) segments of a segmented two
+ *  colors horizontal pseudo 3d bar in a Cairo context. 
+ *  @param cr  Cairo context.
+ *  @param x0  X position.
+ *  @param y0  Y position.
+ *  @param width  Bar width.
+ *  @param height  Bar height.
+ *  @param min  Start of activated (highlighted) part of the arc. Relative
+ *  value [0..1].
+ *  @param max  End of activated (highlighted) part of the arc. Relative
+ *  value [0..1].
+ *  @param step  Size of each segment.
+ *  @param colors  Segment color lookup table as calculated by
+ *  @c makeMeterSegmentColors() .
+ *
+ *  Only draws the segments within [@a min, @a max] on top of the elements 
+ *  drawn by @c drawHMeterStatic() . Neighboring segments of the
+ *  same color are drawn together in a single fill.
+ */
+inline void drawHMeterActive  (cairo_t* cr, const double x0, const double y0, const double width, const double height, 
+                             const double min, const double max, const double step,
+                             const std::vector<MeterSegmentColor>& colors)
+{
+    const double dx = (width - 0.2 * height) * step;
+    const MeterSegmentColor* run = nullptr;
+
+    cairo_set_line_width (cr, 0.0);
+
+    // Fills all segments of a run of the same color
+    auto fillRun = [&] ()
+    {
+        cairo_pattern_t* fgPat = cairo_pattern_create_linear (x0, y0, x0 + width, y0 + height);
+        if (fgPat && (cairo_pattern_status (fgPat) == CAIRO_STATUS_SUCCESS))
+        {
+            cairo_pattern_add_color_stop_rgba (fgPat, 0, CAIRO_RGBA(run->lo));
+            cairo_pattern_add_color_stop_rgba (fgPat, 0.25, CAIRO_RGBA(run->hi));
+            cairo_pattern_add_color_stop_rgba (fgPat, 1, CAIRO_RGBA(run->lo));
+            cairo_set_source (cr, fgPat);
+            cairo_fill (cr);
+        }
+        else cairo_new_path (cr);
+        if (fgPat) cairo_pattern_destroy (fgPat);
+    };
+
+    size_t i = 0;
+    for (double v = 0; (v < 1.0) && (i < colors.size()); v += step, ++i)
+    {
+        if ((v < min) || (v > max)) continue;
+
+        if (run && (colors[i] != *run)) fillRun ();
+        if ((!run) || (colors[i] != *run)) run = &colors[i];
+
+        const double x = v * (width - 0.2 * height);
+
+        if (dx < 3.0) cairo_rectangle (cr, x0 + 0.1 * height + x, y0 + 0.1 * height, dx, height - 0.2 * height);
+        else cairo_rectangle (cr, x0 + 0.1 * height + x + 1.0, y0 + 0.1 * height, dx - 2.0, height - 0.2 * height);
+    }
+
+    if (run) fillRun ();
+}
+
+/**
+ *  @brief  Draws the active (value-dependent) segments of a segmented two
+ *  colors horizontal pseudo 3d bar in a Cairo context. 
+ *  @param cr  Cairo context.
+ *  @param x0  X position.
+ *  @param y0  Y position.
+ *  @param width  Bar width.
+ *  @param height  Bar height.
+ *  @param min  Start of activated (highlighted) part of the arc. Relative
+ *  value [0..1].
+ *  @param max  End of activated (highlighted) part of the arc. Relative
+ *  value [0..1].
+ *  @param step  Size of each segment.
+ *  @param loColor  RGBA color for the low values of the activated part.
+ *  @param hiColor  RGBA color for the high values of the activated part.
+ *  @param gradient  Color gradient function.
+ *
+ *  Only draws the segments within [@a min, @a max] on top of the elements 
+ *  drawn by @c drawHMeterStatic() .
+ */
+inline void drawHMeterActive  (cairo_t* cr, const double x0, const double y0, const double width, const double height, 
+                             const double min, const double max, const double step,
+                             const BStyles::Color loColor, const BStyles::Color hiColor, std::function<double(const double &)> gradient)
+{
+    std::vector<MeterSegmentColor> colors;
+    makeMeterSegmentColors (colors, step, loColor, hiColor, gradient);
+    drawHMeterActive (cr, x0, y0, width, height, min, max, step, colors);
+}
+
+/**
+ *  @brief  Draws a segmented two colors horizontal pseudo 3d bar in a Cairo
+ *  context. 
+ *  @param cr  Cairo context.
+ *  @param x0  X position.
+ *  @param y0  Y position.
+ *  @param width  Bar width.
+ *  @param height  Bar height.
+ *  @param min  Start of activated (highlighted) part of the arc. Relative
+ *  value [0..1].
+ *  @param max  End of activated (highlighted) part of the arc. Relative
+ *  value [0..1].
+ *  @param step  Size of each segment.
+ *  @param loColor  RGBA color for the low values of the activated part.
+ *  @param hiColor  RGBA color for the high values of the activated part.
+ *  @param gradient  Color gradient function.
+ *  @param bgColor  Bar RGBA color.
+ */
+inline void drawHMeter    (cairo_t* cr, const double x0, const double y0, const double width, const double height, 
+                             const double min, const double max, const double step,
+                             const BStyles::Color loColor, const BStyles::Color hiColor, std::function<double(const double &)> gradient, 
+                             const BStyles::Color bgColor)
+{
+    drawHMeterStatic (cr, x0, y0, width, height, step, bgColor);
+    drawHMeterActive (cr, x0, y0, width, height, min, max, step, loColor, hiColor, gradient);
+}
+
 #endif /*  BWIDGETS_DRAWHMETER_HPP_ */
\ No newline at end of file
@@ -37,33 +37,25 @@
 #endif
 
 /**
- *  @brief  Draws a segmented two colors pseudo 3d arc in a Cairo context. 
+ *  @brief  Draws the static (value-independent) elements of a segmented
+ *  pseudo 3d arc in a Cairo context. 
  *  @param cr  Cairo context.
  *  @param xc  X center position.
  *  @param y0  Y center position.
  *  @param radius  Arc radius.
- *  @param min  Start of activated (highlighted) part of the arc. Relative
- *  value [0..1].
- *  @param max  End of activated (highlighted) part of the arc. Relative
- *  value [0..1].
  *  @param step  Size of each segment.
- *  @param loColor  RGBA color for the low values of the activated part.
- *  @param hiColor  RGBA color for the high values of the activated part.
- *  @param gradient  Color gradient function.
  *  @param bgColor  Bar RGBA color.
+ *
+ *  Draws the background, the border, and all segments in their inactive
+ *  state. The result only depends on the geometry, @a step and @a bgColor
+ *  and thus may be cached and blitted before calling @c drawRMeterActive() .
  */
-inline void drawRMeter    (cairo_t* cr, const double xc, const double yc, const double radius,
-                             const double min, const double max, const double step,
-                             const BStyles::Color loColor, const BStyles::Color hiColor, std::function<double(const double &)> gradient, 
-                             const BStyles::Color bgColor)
+inline void drawRMeterStatic  (cairo_t* cr, const double xc, const double yc, const double radius,
+                                 const double step, const BStyles::Color bgColor)
 {
     // Colors used
     const double da = (1.5 * M_PI) * step;
     const double sa = 1.0 / radius;
-    const BStyles::Color fgHi = loColor.illuminate (BStyles::Color::illuminated);
-    const BStyles::Color fgLo = loColor;
-    const BStyles::Color hiHi = hiColor.illuminate (BStyles::Color::illuminated);
-    const BStyles::Color hiLo = hiColor;
     const BStyles::Color bgLo = bgColor.illuminate (BStyles::Color::shadowed);
     const BStyles::Color bgHi = bgColor;
     const BStyles::Color bgDk = bgColor.illuminate (-0.75);
@@ -89,51 +81,106 @@ inline void drawRMeter    (cairo_t* cr, const double xc, const double yc, const
         cairo_pattern_destroy (pat);
     }
 
-    // Fill
+    // Inactive segments
     cairo_set_line_width (cr, 0.0);
-    cairo_pattern_t* fgPat = cairo_pattern_create_linear (xc - radius, yc - radius, xc + radius, yc + radius);
     cairo_pattern_t* bgPat = cairo_pattern_create_linear (xc - radius, yc - radius, xc + radius, yc + radius);
-    if (fgPat && bgPat && (cairo_pattern_status (fgPat) == CAIRO_STATUS_SUCCESS) && (cairo_pattern_status (bgPat) == CAIRO_STATUS_SUCCESS))
+    if (bgPat && (cairo_pattern_status (bgPat) == CAIRO_STATUS_SUCCESS))
     {
-        cairo_pattern_add_color_stop_rgba (fgPat, 0, CAIRO_RGBA(fgLo));
-        cairo_pattern_add_color_stop_rgba (fgPat, 0.25, CAIRO_RGBA(fgHi));
-        cairo_pattern_add_color_stop_rgba (fgPat, 1, CAIRO_RGBA(fgLo));
         cairo_pattern_add_color_stop_rgba (bgPat, 0, CAIRO_RGBA(bgLo));
         cairo_pattern_add_color_stop_rgba (bgPat, 0.25, CAIRO_RGBA(bgHi));
         cairo_pattern_add_color_stop_rgba (bgPat, 1, CAIRO_RGBA(bgLo));
+        cairo_set_source (cr, bgPat);
 
         for (double v = 0; v < 1.0; v += step)
         {
-            if ((v >= min) && (v <=max)) 
+            const double a = 0.75 * M_PI + v * (1.5 * M_PI);
+
+            if (da < 3.0 * sa) 
             {
-                if ((fgHi != hiHi) || (fgLo != hiLo))
-                {
-                    fgPat = cairo_pattern_create_linear (xc - radius, yc - radius, xc + radius, yc + radius);
-                    BStyles::Color cLo; 
-                    cLo.setHSV
-                    (
-                        fgLo.hue() * (1.0 - gradient (v)) + hiLo.hue() * gradient (v),
-                        fgLo.saturation() * (1.0 - gradient (v)) + hiLo.saturation() * gradient (v),
-                        fgLo.value() * (1.0 - gradient (v)) + hiLo.value() * gradient (v),
-                        fgLo.alpha * (1.0 - gradient (v)) + hiLo.alpha * gradient (v)
-                    );
-                    BStyles::Color cHi;
-                    cHi.setHSV
-                    (
-                        fgHi.hue() * (1.0 - gradient (v)) + hiHi.hue() * gradient (v),
-                        fgHi.saturation() * (1.0 - gradient (v)) + hiHi.saturation() * gradient (v),
-                        fgHi.value() * (1.0 - gradient (v)) + hiHi.value() * gradient (v),
-                        fgHi.alpha * (1.0 - gradient (v)) + hiHi.alpha * gradient (v)
-                    );
-
-                    cairo_pattern_add_color_stop_rgba (fgPat, 0, CAIRO_RGBA(cLo));
-                    cairo_pattern_add_color_stop_rgba (fgPat, 0.25, CAIRO_RGBA(cHi));
-                    cairo_pattern_add_color_stop_rgba (fgPat, 1, CAIRO_RGBA(cLo));
-                }
-                cairo_set_source (cr, fgPat);
+                cairo_arc (cr, xc, yc, 0.91 * radius, a, a + da);
+                cairo_arc_negative (cr, xc, yc, 0.55 * radius, a + da, a);
+            }
+            else 
+            {
+                cairo_arc (cr, xc, yc, 0.91 * radius, a + sa, a + da - sa);
+                cairo_arc_negative (cr, xc, yc, 0.55 * radius, a + da - sa, a + sa);
             }
+            cairo_fill (cr);
+        }
 
-            else cairo_set_source (cr, bgPat);
+        cairo_pattern_destroy (bgPat);
+    }
+}
+
+/**
+ *  @brief  Draws the active (value-dependent) segments of a segmented two
+ *  colors pseudo 3d arc in a Cairo context. 
+ *  @param cr  Cairo context.
+ *  @param xc  X center position.
+ *  @param y0  Y center position.
+ *  @param radius  Arc radius.
+ *  @param min  Start of activated (highlighted) part of the arc. Relative
+ *  value [0..1].
+ *  @param max  End of activated (highlighted) part of the arc. Relative
+ *  value [0..1].
+ *  @param step  Size of each segment.
+ *  @param loColor  RGBA color for the low values of the activated part.
+ *  @param hiColor  RGBA color for the high values of the activated part.
+ *  @param gradient  Color gradient function.
+ *
+ *  Only draws the segments within [@a min, @a max] on top of the elements 
+ *  drawn by @c drawRMeterStatic() .
+ */
+inline void drawRMeterActive  (cairo_t* cr, const double xc, const double yc, const double radius,
+                                 const double min, const double max, const double step,
+                                 const BStyles::Color loColor, const BStyles::Color hiColor, std::function<double(const double &)> gradient)
+{
+    // Colors used
+    const double da = (1.5 * M_PI) * step;
+    const double sa = 1.0 / radius;
+    const BStyles::Color fgHi = loColor.illuminate (BStyles::Color::illuminated);
+    const BStyles::Color fgLo = loColor;
+    const BStyles::Color hiHi = hiColor.illuminate (BStyles::Color::illuminated);
+    const BStyles::Color hiLo = hiColor;
+
+    // Fill
+    cairo_set_line_width (cr, 0.0);
+    cairo_pattern_t* fgPat = cairo_pattern_create_linear (xc - radius, yc - radius, xc + radius, yc + radius);
+    if (fgPat && (cairo_pattern_status (fgPat) == CAIRO_STATUS_SUCCESS))
+    {
+        cairo_pattern_add_color_stop_rgba (fgPat, 0, CAIRO_RGBA(fgLo));
+        cairo_pattern_add_color_stop_rgba (fgPat, 0.25, CAIRO_RGBA(fgHi));
+        cairo_pattern_add_color_stop_rgba (fgPat, 1, CAIRO_RGBA(fgLo));
+
+        for (double v = 0; v < 1.0; v += step)
+        {
+            if ((v < min) || (v > max)) continue;
+
+            if ((fgHi != hiHi) || (fgLo != hiLo))
+            {
+                fgPat = cairo_pattern_create_linear (xc - radius, yc - radius, xc + radius, yc + radius);
+                BStyles::Color cLo; 
+                cLo.setHSV
+                (
+                    fgLo.hue() * (1.0 - gradient (v)) + hiLo.hue() * gradient (v),
+                    fgLo.saturation() * (1.0 - gradient (v)) + hiLo.saturation() * gradient (v),
+                    fgLo.value() * (1.0 - gradient (v)) + hiLo.value() * gradient (v),
+                    fgLo.alpha * (1.0 - gradient (v)) + hiLo.alpha * gradient (v)
+                );
+                BStyles::Color cHi;
+                cHi.setHSV
+                (
+                    fgHi.hue() * (1.0 - gradient (v)) + hiHi.hue() * gradient (v),
+                    fgHi.saturation() * (1.0 - gradient (v)) + hiHi.saturation() * gradient (v),
+                    fgHi.value() * (1.0 - gradient (v)) + hiHi.value() * gradient (v),
+                    fgHi.alpha * (1.0 - gradient (v)) + hiHi.alpha * gradient (v)
+                );
+
+                cairo_pattern_add_color_stop_rgba (fgPat, 0, CAIRO_RGBA(cLo));
+                cairo_pattern_add_color_stop_rgba (fgPat, 0.25, CAIRO_RGBA(cHi));
+                cairo_pattern_add_color_stop_rgba (fgPat, 1, CAIRO_RGBA(cLo));
+            }
+            cairo_set_source (cr, fgPat);
 
             const double a = 0.75 * M_PI + v * (1.5 * M_PI);
 
@@ -150,9 +197,33 @@ inline void drawRMeter    (cairo_t* cr, const double xc, const double yc, const
             cairo_fill (cr);
         }
 
-        cairo_pattern_destroy (bgPat);
         cairo_pattern_destroy (fgPat);
     }
 }
 
+/**
+ *  @brief  Draws a segmented two colors pseudo 3d arc in a Cairo context. 
+ *  @param cr  Cairo context.
+ *  @param xc  X center position.
+ *  @param y0  Y center position.
+ *  @param radius  Arc radius.
+ *  @param min  Start of activated (highlighted) part of the arc. Relative
+ *  value [0..1].
+ *  @param max  End of activated (highlighted) part of the arc. Relative
+ *  value [0..1].
+ *  @param step  Size of each segment.
+ *  @param loColor  RGBA color for the low values of the activated part.
+ *  @param hiColor  RGBA color for the high values of the activated part.
+ *  @param gradient  Color gradient function.
+ *  @param bgColor  Bar RGBA color.
+ */
+inline void drawRMeter    (cairo_t* cr, const double xc, const double yc, const double radius,
+                             const double min, const double max, const double step,
+                             const BStyles::Color loColor, const BStyles::Color hiColor, std::function<double(const double &)> gradient, 
+                             const BStyles::Color bgColor)
+{
+    drawRMeterStatic (cr, xc, yc, radius, step, bgColor);
+    drawRMeterActive (cr, xc, yc, radius, min, max, step, loColor, hiColor, gradient);
+}
+
 #endif /*  BWIDGETS_DRAWRMETER_HPP_ */
\ No newline at end of file
@@ -0,0 +1,111 @@
+/* meterSegmentColors.hpp
+ * Copyright (C) 2018 - 2022  Sven Jähnichen
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef BWIDGETS_METERSEGMENTCOLORS_HPP_
+#define BWIDGETS_METERSEGMENTCOLORS_HPP_
+
+#include <cmath>
+#include <functional>
+#include <vector>
+#include "../../BStyles/Types/Color.hpp"
+
+/**
+ *  @brief  Pair of colors used to draw a single meter segment.
+ */
+struct MeterSegmentColor
+{
+    BStyles::Color lo;
+    BStyles::Color hi;
+
+    bool operator== (const MeterSegmentColor& that) const {return (lo == that.lo) && (hi == that.hi);}
+    bool operator!= (const MeterSegmentColor& that) const {return !operator== (that);}
+};
+
+/**
+ *  @brief  Rounds a color to 8 bit per channel.
+ *  @param color  RGBA color.
+ *  @return  Rounded RGBA color.
+ *
+ *  Neighboring segments with the same rounded colors can't be distinguished
+ *  on screen and thus may be drawn together in a single fill.
+ */
+inline BStyles::Color quantizeMeterSegmentColor (const BStyles::Color& color)
+{
+    return BStyles::Color   (std::round (255.0 * color.red) / 255.0,
+                             std::round (255.0 * color.green) / 255.0,
+                             std::round (255.0 * color.blue) / 255.0,
+                             std::round (255.0 * color.alpha) / 255.0);
+}
+
+/**
+ *  @brief  Calculates the color lookup table for the segments of a
+ *  two colors meter.
+ *  @param table  Lookup table to be (re-)filled.
+ *  @param step  Size of each segment.
+ *  @param loColor  RGBA color for the low values.
+ *  @param hiColor  RGBA color for the high values.
+ *  @param gradient  Color gradient function.
+ *
+ *  Stores the illuminated (hi) and non-illuminated (lo) color for each
+ *  segment, starting with the segment at 0.0. Calls @a gradient once per
+ *  segment. The table only depends on the parameters and thus may be kept
+ *  and re-used as long as none of them changes.
+ */
+inline void makeMeterSegmentColors  (std::vector<MeterSegmentColor>& table, const double step,
+                                     const BStyles::Color loColor, const BStyles::Color hiColor,
+                                     std::function<double(const double &)> gradient)
+{
+    table.clear();
+    if (step <= 0.0) return;
+
+    const BStyles::Color fgHi = loColor.illuminate (BStyles::Color::illuminated);
+    const BStyles::Color fgLo = loColor;
+    const BStyles::Color hiHi = hiColor.illuminate (BStyles::Color::illuminated);
+    const BStyles::Color hiLo = hiColor;
+    const bool twoColors = ((fgHi != hiHi) || (fgLo != hiLo));
+
+    for (double v = 0; v < 1.0; v += step)
+    {
+        if (!twoColors)
+        {
+            table.push_back (MeterSegmentColor {fgLo, fgHi});
+            continue;
+        }
+
+        const double g = gradient (v);
+        BStyles::Color cLo;
+        cLo.setHSV
+        (
+            fgLo.hue() * (1.0 - g) + hiLo.hue() * g,
+            fgLo.saturation() * (1.0 - g) + hiLo.saturation() * g,
+            fgLo.value() * (1.0 - g) + hiLo.value() * g,
+            fgLo.alpha * (1.0 - g) + hiLo.alpha * g
+        );
+        BStyles::Color cHi;
+        cHi.setHSV
+        (
+            fgHi.hue() * (1.0 - g) + hiHi.hue() * g,
+            fgHi.saturation() * (1.0 - g) + hiHi.saturation() * g,
+            fgHi.value() * (1.0 - g) + hiHi.value() * g,
+            fgHi.alpha * (1.0 - g) + hiHi.alpha * g
+        );
+
+        table.push_back (MeterSegmentColor {quantizeMeterSegmentColor (cLo), quantizeMeterSegmentColor (cHi)});
+    }
+}
+
+#endif /*  BWIDGETS_METERSEGMENTCOLORS_HPP_ */
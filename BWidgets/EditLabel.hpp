@@ -121,6 +121,14 @@ public:
     virtual void setValue (const std::string& text) override;
 
 	/**
+     *  @brief  Sets the label text (= value).
+     *  @param value  Label text (= value).
+     *
+     *  Equivalent to @c setValue(const std::string&) .
+     */
+    virtual void setValue (std::string&& text) override;
+
+	/**
 	 *  @brief  Sets the label text.
 	 *  @param text  Label text.
 	 *
@@ -296,6 +304,11 @@ inline void EditLabel::copy (const EditLabel* that)
     Label::copy (that);
 }
 
+inline void EditLabel::setValue (std::string&& text)
+{
+	setValue (static_cast<const std::string&> (text));
+}
+
 inline void EditLabel::setValue (const std::string& text)
 {
 	// Set displayed text
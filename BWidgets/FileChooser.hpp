@@ -22,12 +22,14 @@
 #include <cstddef>
 #include <initializer_list>
 #include <regex>
-#include <dirent.h>
+#include <algorithm>
 #include <sys/stat.h>
 #include "Box.hpp"
 #include "Frame.hpp"
 #include "Supports/ValueableTyped.hpp"
 #include "Supports/Closeable.hpp"
+#include "Supports/Pollable.hpp"
+#include "../BUtilities/DirScanner.hpp"
 #include "Symbol.hpp"
 #include "TextButton.hpp"
 #include "EditLabel.hpp"
@@ -63,6 +65,9 @@ namespace BWidgets
  *
  *  The ListBox fascilitates selection of files and the navigation through
  *  the file system. A selected file is also shown in the EditLabel.
+ *  Directories are scanned in the background and the ListBox is filled
+ *  progressively (see @c poll() ). Unchanged directories are taken from a
+ *  cache.
  *  
  *  Clicking on the new folder SymbolButton opens a dialog and the user is
  *  asked to enter a new folder name. The new folder is created within the
@@ -74,7 +79,7 @@ namespace BWidgets
  *  Clicking on "OK" / "Open" will set the widget value to path + filename 
  *  and a CloseRequestEvent is emitted.
  */
-class FileChooser : public Frame, public ValueableTyped<std::string>, public Closeable
+class FileChooser : public Frame, public ValueableTyped<std::string>, public Closeable, public Pollable
 {
 public:
 
@@ -84,9 +89,50 @@ public:
 	typedef std::pair<std::string, std::regex> Filter;
 
 protected:
+
+	/**
+	 *  @brief  ItemSource showing the directories (bold) followed by the
+	 *  files.
+	 */
+	class FileListSource : public ItemSource
+	{
+	protected:
+		const FileChooser* fileChooser_;
+
+	public:
+		FileListSource (const FileChooser* fileChooser) : fileChooser_ (fileChooser) {}
+
+		virtual size_t getItemCount () const override
+		{
+			return fileChooser_->dirs_.size() + fileChooser_->files_.size();
+		}
+
+		virtual std::string getItemText (const size_t pos) const override
+		{
+			const size_t nrDirs = fileChooser_->dirs_.size();
+			if ((pos == 0) || (pos > getItemCount())) return "";
+			return (pos <= nrDirs ? fileChooser_->dirs_[pos - 1] : fileChooser_->files_[pos - 1 - nrDirs]);
+		}
+
+		virtual size_t findItem (const std::string& item) const override
+		{
+			return fileChooser_->findListItem (item);
+		}
+
+		virtual void formatItem (const size_t pos, Label* label) const override
+		{
+			BStyles::Font f = label->getFont();
+			f.weight = (pos <= fileChooser_->dirs_.size() ? CAIRO_FONT_WEIGHT_BOLD : CAIRO_FONT_WEIGHT_NORMAL);
+			label->setFont (f);
+		}
+	};
+
 	std::map<std::string, std::regex> filters_;
 	std::vector<std::string> dirs_;
 	std::vector<std::string> files_;
+	FileListSource fileListSource_;
+	BUtilities::DirScanner scanner_;
+	bool listed_;				// First entries of the current scan shown
 
 public:
 
@@ -239,6 +285,14 @@ public:
      */
     virtual void update () override;
 
+	/**
+	 *  @brief  Takes over the directory entries scanned in the background.
+	 *
+	 *  Filters the new entries and inserts them at their sorted position
+	 *  into the file ListBox. Called by the main window once per frame.
+	 */
+	virtual void poll () override;
+
 protected:
 
 	static void fileListBoxChangedCallback (BEvents::Event* event);
@@ -256,7 +310,7 @@ protected:
 
 	virtual std::function<void (BEvents::Event*)> getFileListBoxClickedCallback();
 
-	bool isDir (const std::string& path, const std::string& name) const;
+	size_t findListItem (const std::string& name) const;
 };
 
 inline FileChooser::FileChooser () : 
@@ -285,6 +339,9 @@ inline FileChooser::FileChooser	(const double x, const double y, const double wi
 		filters_ (),
 		dirs_ (),
 		files_ (),
+		fileListSource_ (this),
+		scanner_ (),
+		listed_ (false),
 
 		pathNameBox ("", BUtilities::Urid::urid (BUtilities::Urid::uri (urid) + "/textbox"), ""),
 		newFolderButton (Symbol::NEW_FOLDER_SYMBOL, false, false, BUtilities::Urid::urid (BUtilities::Urid::uri (urid) + "/button"), ""),
@@ -308,6 +365,7 @@ inline FileChooser::FileChooser	(const double x, const double y, const double wi
 		createInput ("", BUtilities::Urid::urid (BUtilities::Urid::uri (urid) + "/textbox"), ""),
 		createError ("", BUtilities::Urid::urid (BUtilities::Urid::uri (urid) + "/label"), "")
 {
+	fileListBox.setItemSource (&fileListSource_);
 	setPath (path);
 	enterDir();
 
@@ -367,6 +425,8 @@ inline void FileChooser::copy (const FileChooser* that)
 	pathNameBox.copy (&that->pathNameBox);
 	newFolderButton.copy (&that->newFolderButton);
 	fileListBox.copy (&that->fileListBox);
+	fileListSource_.changed();
+	fileListBox.setItemSource (&fileListSource_);
 	fileNameLabel.copy (&that->fileNameLabel);
 	fileNameBox.copy (&that->fileNameBox);
 	filterComboBox.copy (&that->filterComboBox);
@@ -595,11 +655,7 @@ inline void FileChooser::fileListBoxChangedCallback (BEvents::Event* event)
 		}
 
 		// File selected
-		else
-		{
-			Label* l = dynamic_cast<Label*>(w->getItem (val));
-			if (l) fc->setFileName (l->getText());
-		}
+		else fc->setFileName (w->getItem (val));
 
 		fc->update();
 	}
@@ -646,10 +702,10 @@ inline void FileChooser::okButtonClickedCallback (BEvents::Event* event)
 		// Dircectory selected: Open directory
 		if (lb <= fc->dirs_.size())
 		{
-			Label* l = dynamic_cast<Label*>(fc->fileListBox.getItem (lb));
-			if (l)
+			const std::string item = fc->fileListBox.getItem (lb);
+			if (item != "")
 			{
-				std::string newPath = fc->getPath() + PATH_SEPARATOR + l->getText();
+				std::string newPath = fc->getPath() + PATH_SEPARATOR + item;
 				char buf[PATH_MAX];
 					char *rp = realpath(newPath.c_str(), buf);
 					if (rp) fc->setPath (rp);
@@ -751,81 +807,104 @@ inline void FileChooser::newFolderButtonClickedCallback (BEvents::Event* event)
 	}
 }
 
-inline bool FileChooser::isDir (const std::string& path, const std::string& name) const
+inline void FileChooser::enterDir ()
 {
-	std::string full = (path == PATH_SEPARATOR ? path : path + PATH_SEPARATOR) + name;
-	struct stat sb;
-        if (stat (full.c_str(), &sb)) return false;
-	if (S_ISDIR(sb.st_mode)) return true;
-	return false;
+	scanner_.scan (getPath());
+	listed_ = false;
+	fileListBox.setFilter ("");
+
+	// Cached directories are available immediately
+	FileChooser::poll();
 }
 
-inline void FileChooser::enterDir ()
+inline void FileChooser::poll ()
 {
+	if (!scanner_.isPending()) return;
+
 	std::vector<std::string> newFiles;
 	std::vector<std::string> newDirs;
-	DIR *dir = opendir (getPath().c_str());
+	const bool complete = scanner_.poll (newDirs, newFiles);
 
-	// Scan directory
-	// TODO Use C++17 for future versions
-	if (dir)
+	// Filter files
+	if (!filters_.empty())
 	{
-		for (struct dirent* entry = readdir(dir); entry ; entry = readdir(dir))
-		{
-			if (isDir (getPath(), entry->d_name))
-			{
-				std::string s = entry->d_name;
-				if ((std::regex_match (s, std::regex ("(\\.{1,2})|([^\\.].*)"))))	// Exclude hidden
-				{
-					newDirs.push_back (entry->d_name);
-				}
-			}
-
-			else
-			{
-				std::string s = entry->d_name;
-				if (!std::regex_match (s, std::regex ("\\..*")))	// Exclude hidden
-				{
-					if (filters_.empty()) newFiles.push_back (s);
-					else
-					{
-						Label* l = dynamic_cast<Label*>(filterComboBox.getItem (filterComboBox.getValue()));
-						if (l && (std::regex_match (s, filters_[l->getText()]))) newFiles.push_back (s);
-					}
-				}
-			}
-		}
-		closedir (dir);
+		const std::regex* filter = nullptr;
+		std::map<std::string, std::regex>::const_iterator it = filters_.find (filterComboBox.getItem (filterComboBox.getValue()));
+		if (it != filters_.end()) filter = &it->second;
+
+		newFiles.erase
+		(
+			std::remove_if 
+			(
+				newFiles.begin(), 
+				newFiles.end(), 
+				[filter] (const std::string& f) {return (!filter) || (!std::regex_match (f, *filter));}
+			), 
+			newFiles.end()
+		);
 	}
 
 	std::sort (newFiles.begin(), newFiles.end());
 	std::sort (newDirs.begin(), newDirs.end());
 
-	if ((files_ != newFiles) || (dirs_ != newDirs))
+	if (!listed_)
 	{
-		files_ = newFiles;
-		dirs_ = newDirs;
-
-		fileListBox.deleteItem();
+		listed_ = true;
 
-		// Directories
-		for (std::string const& d : dirs_) 
+		// Complete listing at once: Only refresh if changed
+		if (complete)
 		{
-			fileListBox.addItem (d);
-			Label* l = dynamic_cast<Label*>(fileListBox.getItem (d));
-			if (l) 
+			if ((files_ != newFiles) || (dirs_ != newDirs))
 			{
-				BStyles::Font f = l->getFont();
-				f.weight = CAIRO_FONT_WEIGHT_BOLD;
-				l->setFont (f);
+				files_ = newFiles;
+				dirs_ = newDirs;
+				fileListSource_.changed();
+				fileListBox.setValue (0);
+				fileListBox.setTop (1);
+				fileListBox.update();
 			}
+			return;
 		}
 
-		// Files
-		for (std::string const& f : files_) fileListBox.addItem (f);
-
+		// Otherwise start a new listing
+		files_.clear();
+		dirs_.clear();
+		fileListSource_.changed();
+		fileListBox.setValue (0);
 		fileListBox.setTop (1);
 	}
+
+	// Merge new entries into the sorted lists. Keep selection and scroll
+	// position (if not type-ahead filtered).
+	const bool filtered = (fileListBox.getFilter() != "");
+	const std::string selected = fileListBox.getItem (fileListBox.getValue());
+	const std::string top = ((!filtered) && (fileListBox.getTop() > 1) ? fileListBox.getItem (fileListBox.getTop()) : "");
+
+	auto merge = [] (std::vector<std::string>& v, const std::vector<std::string>& add)
+	{
+		const size_t size = v.size();
+		v.insert (v.end(), add.begin(), add.end());
+		std::inplace_merge (v.begin(), v.begin() + size, v.end());
+	};
+
+	merge (dirs_, newDirs);
+	merge (files_, newFiles);
+	fileListSource_.changed();
+
+	fileListBox.setValue (selected != "" ? findListItem (selected) : 0);
+	if (!filtered) fileListBox.setTop (top != "" ? findListItem (top) : 1);
+	fileListBox.update();
+}
+
+inline size_t FileChooser::findListItem (const std::string& name) const
+{
+	std::vector<std::string>::const_iterator dit = std::lower_bound (dirs_.begin(), dirs_.end(), name);
+	if ((dit != dirs_.end()) && (*dit == name)) return 1 + (dit - dirs_.begin());
+
+	std::vector<std::string>::const_iterator fit = std::lower_bound (files_.begin(), files_.end(), name);
+	if ((fit != files_.end()) && (*fit == name)) return 1 + dirs_.size() + (fit - files_.begin());
+
+	return 0;
 }
 
 inline void FileChooser::processFileSelected()
@@ -23,9 +23,17 @@
 #include "Supports/Clickable.hpp"
 #include "Supports/Draggable.hpp"
 #include "Supports/Toggleable.hpp"
+#include "Supports/Pollable.hpp"
 #include "../BEvents/WheelEvent.hpp"
+#include "../BUtilities/RingBuffer.hpp"
+#include <algorithm>
+#include <array>
+#include <bitset>
+#include <chrono>
 #include <cmath>
 #include <cstdint>
+#include <map>
+#include <utility>
 #include <vector>
 
 #ifndef BWIDGETS_DEFAULT_HPIANOROLL_WIDTH
@@ -36,6 +44,10 @@
 #define BWIDGETS_DEFAULT_HPIANOROLL_HEIGHT 40.0
 #endif
 
+#ifndef BWIDGETS_DEFAULT_HPIANOROLL_FEED_SIZE
+#define BWIDGETS_DEFAULT_HPIANOROLL_FEED_SIZE 1024
+#endif
+
 namespace BWidgets
 {
 
@@ -46,17 +58,47 @@ namespace BWidgets
  *  It supports user interaction via Clickable, Draggable, and Toggleable. Its
  *  appearance is defined by the BgColors parameter (inactive keys) and by the 
  *  FgColors parameter (active keys).
+ *
+ *  The key states are kept in fixed arrays of 128 velocities and 128 
+ *  activation flags. Changing single keys (e. g., @c setKey() ) doesn't 
+ *  allocate memory and only marks the respective keys as damaged. Only the
+ *  damaged keys are redrawn. Their areas are exposed and the value change
+ *  is emitted once per frame upon @c poll() .
+ *
+ *  Live MIDI notes can be fed from the DSP thread via @c feedNote() or
+ *  @c feedMidi() without locks or memory allocation. The fed notes are
+ *  applied to the active keys once per frame. Optionally, the velocities of
+ *  the fed notes decay over time (@c setVelocityDecay() ).
  */
 class HPianoRoll : 	public Widget, 
 					public ValueableTyped<std::map<uint8_t, uint8_t>>,
 					public Clickable,
 					public Draggable,
-					public Toggleable
+					public Toggleable,
+					public Pollable
 {
 protected:
 	uint8_t startMidiKey_;
 	uint8_t endMidiKey_;
 	uint8_t defaultVelocity_;
+	std::array<uint8_t, 128> velocities_;	// Velocities, 0 for released or inactive keys
+	std::bitset<128> active_;
+	std::bitset<128> damage_;				// Keys to be redrawn
+	std::bitset<128> exposure_;				// Keys to be exposed upon poll()
+	bool fullDraw_;
+	bool valueChanged_;						// Value change to be emitted upon poll()
+
+	struct NoteEvent
+	{
+		uint8_t key;
+		uint8_t velocity;					// 0 for note off
+	};
+
+	BUtilities::RingBuffer<NoteEvent, BWIDGETS_DEFAULT_HPIANOROLL_FEED_SIZE> feed_;
+	double decay_;							// Velocity decay per second
+	std::array<float, 128> levels_;			// Decaying velocities
+	std::bitset<128> decaying_;
+	std::chrono::steady_clock::time_point feedTime_;
 
 public:
 
@@ -138,6 +180,23 @@ public:
 	 *  Copies all properties from another %HPianoRoll. But NOT its linkage.
 	 */
 	void copy (const HPianoRoll* that);
+
+	/**
+	 *  @brief  Changes the value (active keys and their velocities).
+	 *  @param value  Map containing active keys (key_value) and their
+	 *  respective velocities (mapped_value).
+	 */
+	virtual void setValue (const std::map<uint8_t, uint8_t>& value) override;
+
+	/**
+	 *  @brief  Changes the value (active keys and their velocities) by
+	 *  moving.
+	 *  @param value  Map containing active keys (key_value) and their
+	 *  respective velocities (mapped_value).
+	 */
+	virtual void setValue (std::map<uint8_t, uint8_t>&& value) override;
+
+	using ValueableTyped<std::map<uint8_t, uint8_t>>::setValue;
 	
 	/**
      *  @brief  Optimizes the widget extends.
@@ -262,6 +321,13 @@ public:
 	 */
 	std::map<uint8_t, uint8_t> getKeys () const;
 
+	/**
+	 *  @brief Gets the velocities of all keys.
+	 *  @return Array of the velocities of all 128 MIDI keys. 0 for released
+	 *  or inactive keys.
+	 */
+	const std::array<uint8_t, 128>& getVelocities () const;
+
 	/**
 	 *  @brief Sets the velocity to be applied upon clicking on a key.
 	 *  @param velocity  MIDI velocity [0,127].
@@ -274,6 +340,57 @@ public:
 	 */
 	uint8_t getVelocity () const;
 
+	/**
+	 *  @brief  Feeds a note event. Producer thread only (e.g., the DSP 
+	 *  thread).
+	 *  @param key  MIDI key number.
+	 *  @param velocity  Velocity, 0 for note off.
+	 *  @return  True on success, false if the feed buffer is full.
+	 *
+	 *  Fed notes are applied to active keys only. Notes are dropped if the
+	 *  feed buffer is full (e.g., if the GUI is closed).
+	 */
+	bool feedNote (const uint8_t key, const uint8_t velocity);
+
+	/**
+	 *  @brief  Feeds a MIDI message. Producer thread only (e.g., the DSP 
+	 *  thread).
+	 *  @param data  Pointer to the MIDI message.
+	 *  @param size  Size of the MIDI message.
+	 *  @return  True on success or if the message is ignored, false if the
+	 *  feed buffer is full.
+	 *
+	 *  Note on and note off messages of all channels are fed. All other 
+	 *  messages are ignored.
+	 */
+	bool feedMidi (const uint8_t* data, const size_t size);
+
+	/**
+	 *  @brief  Sets the decay of the velocities of fed notes.
+	 *  @param velocityPerSecond  Decay in velocity units per second. 0.0
+	 *  (default) for no decay.
+	 *
+	 *  Decaying notes are released if their velocity reaches 0.
+	 */
+	void setVelocityDecay (const double velocityPerSecond);
+
+	/**
+	 *  @brief  Gets the decay of the velocities of fed notes.
+	 *  @return  Decay in velocity units per second.
+	 */
+	double getVelocityDecay () const;
+
+	/**
+     *  @brief  Method to be called following an object state change.
+     */
+    virtual void update () override;
+
+	/**
+	 *  @brief  Applies the fed notes, exposes the areas of the changed keys,
+	 *  and emits the value change. Called by the main window once per frame.
+	 */
+	virtual void poll () override;
+
 	/**
      *  @brief  Method called when pointer button pressed.
      *  @param event  Passed Event.
@@ -315,6 +432,46 @@ protected:
 	 */
 	virtual uint8_t getKey (const BUtilities::Point<>& position);
 
+	/**
+	 *  @brief  Applies the velocity decay and all notes fed since the last
+	 *  call. GUI thread only.
+	 */
+	void processFeed ();
+
+	/**
+	 *  @brief  Activates (or inactivates) a single key without range check.
+	 *  @param key  MIDI key number.
+	 *  @param active  True if active, otherwise false.
+	 */
+	void setActive (const uint8_t key, const bool active);
+
+	/**
+	 *  @brief  Marks a key as changed.
+	 *  @param key  MIDI key number.
+	 */
+	void damageKey (const uint8_t key);
+
+	/**
+	 *  @brief  Gets the area of a key.
+	 *  @param key  MIDI key number.
+	 *  @return  Area relative to the widget origin, aligned to full pixels
+	 *  and limited to the effective widget area. Empty if the key is out of
+	 *  the range.
+	 */
+	BUtilities::Area<> getKeyArea (const uint8_t key) const;
+
+	/**
+	 *  @brief  Draws all keys intersecting an area.
+	 *  @param cr  Cairo context.
+	 *  @param area  Area.
+	 */
+	void drawKeys (cairo_t* cr, const BUtilities::Area<>& area);
+
+	/**
+	 *  @brief  Redraws the damaged keys only.
+	 */
+	void drawDamage ();
+
 	/**
      *  @brief  Unclipped draw a %HPianoRoll to the surface.
      */
@@ -395,10 +552,22 @@ inline HPianoRoll::HPianoRoll	(const double x, const double y, const double widt
 	Toggleable(),
 	startMidiKey_(startMidiKey),
 	endMidiKey_ (endMidiKey),
-	defaultVelocity_ (64)
+	defaultVelocity_ (64),
+	velocities_ (),
+	active_ (),
+	damage_ (),
+	exposure_ (),
+	fullDraw_ (true),
+	valueChanged_ (false),
+	feed_ (),
+	decay_ (0.0),
+	levels_ (),
+	decaying_ (),
+	feedTime_ (std::chrono::steady_clock::now())
 {
 	setToggleable (false);
 	activate (keys);
+	valueChanged_ = false;
 }
 	
 inline HPianoRoll::HPianoRoll	(const double x, const double y, const double width, const double height, 
@@ -411,9 +580,28 @@ inline HPianoRoll::HPianoRoll	(const double x, const double y, const double widt
 	Toggleable(),
 	startMidiKey_(startMidiKey),
 	endMidiKey_ (endMidiKey),
-	defaultVelocity_ (64)
+	defaultVelocity_ (64),
+	velocities_ (),
+	active_ (),
+	damage_ (),
+	exposure_ (),
+	fullDraw_ (true),
+	valueChanged_ (false),
+	feed_ (),
+	decay_ (0.0),
+	levels_ (),
+	decaying_ (),
+	feedTime_ (std::chrono::steady_clock::now())
 {
 	setToggleable (false);
+	for (std::map<uint8_t, uint8_t>::const_reference k : value_)
+	{
+		if (k.first < 128)
+		{
+			active_[k.first] = true;
+			velocities_[k.first] = k.second;
+		}
+	}
 }
 
 inline Widget* HPianoRoll::clone () const
@@ -428,6 +616,14 @@ inline void HPianoRoll::copy (const HPianoRoll* that)
 	startMidiKey_ = that->startMidiKey_;
 	endMidiKey_ = that->endMidiKey_;
 	defaultVelocity_ = that->defaultVelocity_;
+	velocities_ = that->velocities_;
+	active_ = that->active_;
+	damage_.reset();
+	exposure_.reset();
+	fullDraw_ = true;
+	valueChanged_ = false;
+	decay_ = that->decay_;
+	decaying_.reset();
 	Toggleable::operator= (*that);
 	Draggable::operator= (*that);
 	Clickable::operator= (*that);
@@ -435,6 +631,30 @@ inline void HPianoRoll::copy (const HPianoRoll* that)
 	Widget::copy (that);
 }
 
+inline void HPianoRoll::setValue (const std::map<uint8_t, uint8_t>& value)
+{
+	if (value == value_) return;
+	setValue (std::map<uint8_t, uint8_t> (value));
+}
+
+inline void HPianoRoll::setValue (std::map<uint8_t, uint8_t>&& value)
+{
+	if (value == value_) return;
+
+	velocities_.fill (0);
+	active_.reset();
+	for (std::map<uint8_t, uint8_t>::const_reference k : value)
+	{
+		if (k.first < 128)
+		{
+			active_[k.first] = true;
+			velocities_[k.first] = k.second;
+		}
+	}
+
+	ValueableTyped<std::map<uint8_t, uint8_t>>::setValue (std::move (value));
+}
+
 inline void HPianoRoll::resize ()
 {
 	BUtilities::Area<> a = (children_.empty()? BUtilities::Area<>(0, 0, BWIDGETS_DEFAULT_HPIANOROLL_WIDTH, BWIDGETS_DEFAULT_HPIANOROLL_HEIGHT) : BUtilities::Area<>());
@@ -479,140 +699,67 @@ inline uint8_t HPianoRoll::getEnd () const
 
 inline void HPianoRoll::activate (bool active)
 {
-	std::map<uint8_t, uint8_t> keys = getValue();
-	for (uint8_t i = startMidiKey_; i <= endMidiKey_; ++i)
-	{
-		std::map<uint8_t, uint8_t>::iterator it = keys.find (i);
-		
-		// Add new active keys
-		if (active && (it == keys.end())) keys[i] = 0;
-
-		// Remove existing inactive keys
-		else if ((!active) && (it != keys.end())) keys.erase (it);
-	}
-
-	setValue (keys);
+	for (int i = startMidiKey_; (i <= endMidiKey_) && (i < 128); ++i) setActive (i, active);
 }
 
 inline void HPianoRoll::activate (const uint8_t key, bool active)
 {
-	if (key > endMidiKey_) return;
-
-	std::map<uint8_t, uint8_t> keys = getValue();
-	std::map<uint8_t, uint8_t>::iterator it = keys.find (key);
-		
-	// Add new active keys
-	if (active && (it == keys.end())) 
-	{
-		keys[key] = 0;
-		setValue (keys);
-	}
-
-	// Remove existing inactive keys
-	else if ((!active) && (it != keys.end())) 
-	{
-		keys.erase (it);
-		setValue (keys);
-	}
+	if (key < 128) setActive (key, active);
 }
 
 inline void HPianoRoll::activate (const uint8_t from, const uint8_t to, bool active)
 {
-	std::map<uint8_t, uint8_t> keys = getValue();
-
-	for (uint8_t i = from; i <= to; ++i)
-	{
-		std::map<uint8_t, uint8_t>::iterator it = keys.find (i);
-			
-		// Add new active keys
-		if (active && (it == keys.end())) keys[i] = 0;
-
-		// Remove existing inactive keys
-		else if ((!active) && (it != keys.end())) keys.erase (it);
-	}
-
-	setValue (keys);
+	for (int i = from; (i <= to) && (i < 128); ++i) setActive (i, active);
 }
 
 inline void HPianoRoll::activate (const std::vector<uint8_t>& keys)
 {
-	std::map<uint8_t, uint8_t> k1 = getValue();
-	std::vector<uint8_t> k2 = keys;
-
-	// Remove entries from keys_ missing in keys
-	for (std::map<uint8_t, uint8_t>::iterator it1 = k1.begin(); it1 != k1.end(); /* empty */)
-	{
-		std::vector<uint8_t>::const_iterator it2 = std::find (k2.begin(), k2.end(), it1->first);
-		if (it2 == k2.cend()) 
-		{
-			it1 = k1.erase (it1);
-			k2.erase (it2);
-		}
-		else ++it1;
-	}
-
-	// Add new entries
-	for (const uint8_t k : k2) 
+	std::bitset<128> a;
+	for (const uint8_t k : keys) 
 	{
-		if (k <= 127) k1[k] = 0;
+		if (k < 128) a[k] = true;
 	}
 
-	setValue (k1);
+	for (int i = 0; i < 128; ++i) setActive (i, a[i]);
 }
 
 inline bool HPianoRoll::isActive (const uint8_t key) const
 {
-	return (value_.find(key) != value_.end());
+	return (key < 128) && active_[key];
 }
 
 inline std::vector<uint8_t> HPianoRoll::getActive () const
 {
 	std::vector<uint8_t> k2 {};
-	for (std::map<uint8_t, uint8_t>::const_reference k : value_) k2.push_back(k.first);
+	for (int i = 0; i < 128; ++i)
+	{
+		if (active_[i]) k2.push_back(i);
+	}
 	return k2;
 }
 
 inline void HPianoRoll::setKey (const uint8_t key, uint8_t velocity)
 {
-	std::map<uint8_t, uint8_t> keys = getValue();
-	std::map<uint8_t, uint8_t>::iterator it = keys.find(key);
-	if ((it != keys.end()) && (it->second != velocity))
-	{
-		it->second = velocity;
-		setValue(keys);
-	}
+	if ((key >= 128) || (!active_[key]) || (velocities_[key] == velocity)) return;
+
+	velocities_[key] = velocity;
+	value_.find (key)->second = velocity;
+	damageKey (key);
 }
 
 inline uint8_t HPianoRoll::getKey (const uint8_t key) const
 {
-	std::map<uint8_t, uint8_t>::const_iterator it = value_.find(key);
-	return (it != value_.end() ? it->second : 0);
+	return (key < 128 ? velocities_[key] : 0);
 }
 
 inline void HPianoRoll::setKeys (const std::vector<uint8_t>& keys, uint8_t velocity)
 {
-	std::map<uint8_t, uint8_t> k2 = getValue();
-
-	for (const uint8_t k : keys) 
-	{
-		std::map<uint8_t, uint8_t>::iterator it = k2.find(k);
-		if (it != k2.end()) it->second = velocity;
-	}
-
-	setValue (k2);
+	for (const uint8_t k : keys) setKey (k, velocity);
 }
 
 inline void HPianoRoll::setKeys (const std::map<uint8_t, uint8_t>& keys)
 {
-	std::map<uint8_t, uint8_t> k2 = getValue();
-
-	for (std::map<uint8_t, uint8_t>::const_reference k : keys) 
-	{
-		std::map<uint8_t, uint8_t>::iterator it = k2.find (k.first);
-		if (it != k2.end()) it->second = k.second;
-	}
-
-	setValue (k2);
+	for (std::map<uint8_t, uint8_t>::const_reference k : keys) setKey (k.first, k.second);
 }
 
 inline std::map<uint8_t, uint8_t> HPianoRoll::getKeys () const
@@ -620,6 +767,11 @@ inline std::map<uint8_t, uint8_t> HPianoRoll::getKeys () const
 	return value_;
 }
 
+inline const std::array<uint8_t, 128>& HPianoRoll::getVelocities () const
+{
+	return velocities_;
+}
+
 inline void HPianoRoll::setVelocity (const uint8_t velocity)
 {
 	defaultVelocity_ = velocity;
@@ -630,6 +782,73 @@ inline uint8_t HPianoRoll::getVelocity () const
 	return defaultVelocity_;
 }
 
+inline bool HPianoRoll::feedNote (const uint8_t key, const uint8_t velocity)
+{
+	return feed_.push (NoteEvent {key, velocity});
+}
+
+inline bool HPianoRoll::feedMidi (const uint8_t* data, const size_t size)
+{
+	if ((!data) || (size < 3)) return true;
+
+	const uint8_t status = data[0] & 0xF0;
+	if (status == 0x90) return feedNote (data[1] & 0x7F, data[2] & 0x7F);
+	if (status == 0x80) return feedNote (data[1] & 0x7F, 0);
+	return true;
+}
+
+inline void HPianoRoll::setVelocityDecay (const double velocityPerSecond)
+{
+	decay_ = velocityPerSecond;
+	if (decay_ <= 0.0) decaying_.reset();
+}
+
+inline double HPianoRoll::getVelocityDecay () const
+{
+	return decay_;
+}
+
+inline void HPianoRoll::update ()
+{
+	fullDraw_ = true;
+	Widget::update();
+}
+
+inline void HPianoRoll::poll ()
+{
+	processFeed ();
+
+	if (exposure_.any())
+	{
+		if ((!fullDraw_) && isVisible())
+		{
+			BUtilities::Area<> a;
+			for (int i = 0; i < 128; ++i)
+			{
+				if (exposure_[i])
+				{
+					const BUtilities::Area<> ka = getKeyArea (i);
+					if (a == BUtilities::Area<>()) a = ka;
+					else a.extend (ka);
+				}
+			}
+
+			if (a != BUtilities::Area<>())
+			{
+				a.moveTo (a.getPosition() + getAbsolutePosition());
+				emitExposeEvent (a);
+			}
+		}
+		exposure_.reset();
+	}
+
+	if (valueChanged_)
+	{
+		valueChanged_ = false;
+		emitValueChanged();
+	}
+}
+
 inline void HPianoRoll::onButtonPressed (BEvents::Event* event)
 {
 	BEvents::PointerEvent* pev = dynamic_cast<BEvents::PointerEvent*>(event);
@@ -740,11 +959,179 @@ inline uint8_t HPianoRoll::getKey (const BUtilities::Point<>& position)
 	return 255;
 }
 
-inline void HPianoRoll::draw ()
+inline void HPianoRoll::processFeed ()
 {
-	draw (0, 0, getWidth(), getHeight());
+	const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+	const double dt = std::chrono::duration<double> (now - feedTime_).count();
+	feedTime_ = now;
+
+	// Decay first, thus notes fed in this frame start with their full velocity
+	if (decaying_.any())
+	{
+		const float dv = decay_ * dt;
+		for (int i = 0; i < 128; ++i)
+		{
+			if (!decaying_[i]) continue;
+
+			// Stop decay if changed by other means (e.g., setKey())
+			if (velocities_[i] != uint8_t (std::ceil (levels_[i])))
+			{
+				decaying_[i] = false;
+				continue;
+			}
+
+			levels_[i] = std::max (levels_[i] - dv, 0.0f);
+			if (levels_[i] == 0.0f) decaying_[i] = false;
+			setKey (i, std::ceil (levels_[i]));
+		}
+	}
+
+	// Fed notes. Only the final state of each key is drawn.
+	NoteEvent ev;
+	while (feed_.pop (ev))
+	{
+		if ((ev.key >= 128) || (!active_[ev.key])) continue;
+
+		setKey (ev.key, ev.velocity);
+		levels_[ev.key] = ev.velocity;
+		decaying_[ev.key] = (decay_ > 0.0) && (ev.velocity != 0);
+	}
+}
+
+inline void HPianoRoll::setActive (const uint8_t key, const bool active)
+{
+	if (active_[key] == active) return;
+
+	active_[key] = active;
+	velocities_[key] = 0;
+	if (active) value_.emplace (key, 0);
+	else value_.erase (key);
+	damageKey (key);
 }
 
+inline void HPianoRoll::damageKey (const uint8_t key)
+{
+	damage_[key] = true;
+	exposure_[key] = true;
+	valueChanged_ = true;
+	scheduleDraw_ = true;
+}
+
+inline BUtilities::Area<> HPianoRoll::getKeyArea (const uint8_t key) const
+{
+	const double x0 = getXOffset();
+	const double y0 = getYOffset();
+	const double w = getEffectiveWidth();
+	const double h = getEffectiveHeight();
+	if ((key < startMidiKey_) || (key > endMidiKey_) || (w < 2) || (h < 2)) return BUtilities::Area<> ();
+
+	const uint8_t startKeyNrOffset = startMidiKey_ % 12;
+	const uint8_t endKeyNrOffset = endMidiKey_ % 12;
+	const double startKeyX = keyCoords[startKeyNrOffset].x + (int (startMidiKey_ / 12)) * 7;
+	const double endKeyX = keyCoords[endKeyNrOffset].x + keyCoords[endKeyNrOffset].width + (int (endMidiKey_ / 12)) * 7;
+	const double xs = w / (endKeyX - startKeyX);
+
+	const uint8_t keyNrOffset = key % 12;
+	const double keyX = keyCoords[keyNrOffset].x + (int (key / 12)) * 7 - startKeyX;
+	const double x1 = floor (x0 + keyX * xs - 1.0);
+	const double x2 = ceil (x0 + (keyX + keyCoords[keyNrOffset].width) * xs + 1.0);
+	const double y2 = ceil (y0 + (keyCoords[keyNrOffset].whiteKey ? h : 0.6667 * h) + 1.0);
+	BUtilities::Area<> a = BUtilities::Area<> (x1, floor (y0 - 1.0), x2 - x1, y2 - floor (y0 - 1.0));
+	a.intersect (BUtilities::Area<> (x0, y0, w, h));
+	return a;
+}
+
+inline void HPianoRoll::drawKeys (cairo_t* cr, const BUtilities::Area<>& area)
+{
+	const double x0 = getXOffset();
+	const double y0 = getYOffset();
+	const double w = getEffectiveWidth();
+	const double h = getEffectiveHeight();
+
+	const uint8_t startKeyNrOffset = startMidiKey_ % 12;
+	const uint8_t endKeyNrOffset = endMidiKey_ % 12;
+	const double startKeyX = keyCoords[startKeyNrOffset].x + (int (startMidiKey_ / 12)) * 7;
+	const double endKeyX = keyCoords[endKeyNrOffset].x + keyCoords[endKeyNrOffset].width + (int (endMidiKey_ / 12)) * 7;
+	const double xs = w / (endKeyX - startKeyX);
+
+	// Colors: inactive, active, and pressed for white and black keys
+	const BStyles::Color fg = getFgColors()[getStatus()];
+	const BStyles::Color bg = getBgColors()[getStatus()];
+	const BStyles::Color whiteColors[3] = {bg.illuminate (0), bg.illuminate (0.75), fg.illuminate (0.333)};
+	const BStyles::Color blackColors[3] = {bg.illuminate (-0.5), bg.illuminate (-0.75), fg.illuminate (-0.5)};
+
+	cairo_set_line_width (cr, 0.0);
+
+	for (int k = startMidiKey_; (k <= endMidiKey_) && (k < 128); ++k)
+	{
+		const uint8_t keyNrOffset = k % 12;
+		const double keyX = keyCoords[keyNrOffset].x + (int (k / 12)) * 7 - startKeyX;
+
+		// Skip keys outside the area
+		if 
+		(
+			(x0 + (keyX + keyCoords[keyNrOffset].width) * xs < area.getX()) || 
+			(x0 + keyX * xs > area.getX() + area.getWidth())
+		) continue;
+
+		const int state = (active_[k] ? (velocities_[k] != 0 ? 2 : 1) : 0);
+
+		if (keyCoords[keyNrOffset].whiteKey)
+		{
+			cairo_set_source_rgba (cr, CAIRO_RGBA (whiteColors[state]));
+			cairo_move_to (cr, x0 + (keyX + keyCoords[keyNrOffset].dx1  + 0.025) * xs, y0);
+			cairo_line_to (cr, x0 + (keyX + keyCoords[keyNrOffset].dx1  + 0.025) * xs, y0 + 0.667 * h);
+			cairo_line_to (cr, x0 + (keyX + 0.025) * xs, y0 + 0.667 * h);
+			cairo_line_to (cr, x0 + (keyX + 0.025) * xs, y0 + h - 0.05 * xs);
+			cairo_arc_negative (cr, x0 + (keyX + 0.125) * xs, y0 + h - 0.1 * xs, 0.1 * xs, M_PI, M_PI / 2);
+			cairo_line_to (cr, x0 + (keyX + keyCoords[keyNrOffset].width - 0.125) * xs, y0 + h);
+			cairo_arc_negative (cr, x0 + (keyX + keyCoords[keyNrOffset].width - 0.125) * xs, y0 + h - 0.1 * xs, 0.1 * xs, M_PI / 2, 0);
+			cairo_line_to (cr, x0 + (keyX + keyCoords[keyNrOffset].width - 0.025) * xs, y0 + 0.667 * h);
+			cairo_line_to (cr, x0 + (keyX + keyCoords[keyNrOffset].width - keyCoords[keyNrOffset].dx2 - 0.025) * xs, y0 + 0.667 * h);
+			cairo_line_to (cr, x0 + (keyX + keyCoords[keyNrOffset].width - keyCoords[keyNrOffset].dx2 - 0.025) * xs, y0);
+			cairo_close_path (cr);
+			cairo_fill (cr);
+		}
+		else
+		{
+			cairo_set_source_rgba (cr, CAIRO_RGBA (blackColors[state]));
+			cairoplus_rectangle_rounded (cr, x0 + keyX * xs, y0, keyCoords[keyNrOffset].width * xs, 0.6667 * h, 0.1 * xs, 0b1100);
+			cairo_fill (cr);
+		}
+	}
+}
+
+inline void HPianoRoll::drawDamage ()
+{
+	scheduleDraw_ = false;
+	if ((!surface_) || (cairo_surface_status (surface_) != CAIRO_STATUS_SUCCESS)) return;
+
+	cairo_t* cr = cairo_create (surface_);
+	if (cairo_status (cr) == CAIRO_STATUS_SUCCESS)
+	{
+		for (int i = 0; i < 128; ++i)
+		{
+			if (!damage_[i]) continue;
+
+			const BUtilities::Area<> a = getKeyArea (i);
+			if (a == BUtilities::Area<>()) continue;
+
+			cairo_save (cr);
+			restoreBackground (cr, a);
+			drawKeys (cr, a);
+			cairo_restore (cr);
+		}
+	}
+	cairo_destroy (cr);
+
+	damage_.reset();
+}
+
+inline void HPianoRoll::draw ()
+{
+	if ((!fullDraw_) && damage_.any()) drawDamage ();
+	else draw (0, 0, getWidth(), getHeight());
+}
 inline void HPianoRoll::draw (const double x0, const double y0, const double width, const double height)
 {
 	draw (BUtilities::Area<> (x0, y0, width, height));
@@ -754,8 +1141,9 @@ inline void HPianoRoll::draw (const BUtilities::Area<>& area)
 {
 	if ((!surface_) || (cairo_surface_status (surface_) != CAIRO_STATUS_SUCCESS)) return;
 
-	double x0 = getXOffset();
-	double y0 = getYOffset();
+	fullDraw_ = false;
+	damage_.reset();
+
 	double w = getEffectiveWidth();
 	double h = getEffectiveHeight();
 
@@ -771,65 +1159,7 @@ inline void HPianoRoll::draw (const BUtilities::Area<>& area)
 			cairo_rectangle (cr, area.getX (), area.getY (), area.getWidth (), area.getHeight ());
 			cairo_clip (cr);
 
-			cairo_set_line_width (cr, 0.0);
-
-			uint8_t startKeyNrOffset = startMidiKey_ % 12;
-			uint8_t endKeyNrOffset = endMidiKey_ % 12;
-			double startKeyX = keyCoords[startKeyNrOffset].x + (int (startMidiKey_ / 12)) * 7;
-			double endKeyX = keyCoords[endKeyNrOffset].x + keyCoords[endKeyNrOffset].width + (int (endMidiKey_ / 12)) * 7;
-			double xs = w / (endKeyX - startKeyX);
-
-			for (uint8_t i = 0; i <= endMidiKey_ - startMidiKey_; ++i)
-			{
-				const uint8_t keyNrOffset = (i + startMidiKey_) % 12;
-				const double keyX = keyCoords[keyNrOffset].x + (int ((startMidiKey_ + i) / 12)) * 7 - startKeyX;
-
-				if (keyCoords[keyNrOffset].whiteKey)
-				{
-					const BStyles::Color color =
-					(
-						isActive(i) ?
-						(
-							getKey(i) != 0 ?
-							getFgColors()[getStatus()].illuminate (0.333) :
-							getBgColors()[getStatus()].illuminate (0.75)
-						) :
-						getBgColors()[getStatus()].illuminate (0)
-					);
-
-					cairo_set_source_rgba (cr, CAIRO_RGBA (color));
-					cairo_move_to (cr, x0 + (keyX + keyCoords[keyNrOffset].dx1  + 0.025) * xs, y0);
-					cairo_line_to (cr, x0 + (keyX + keyCoords[keyNrOffset].dx1  + 0.025) * xs, y0 + 0.667 * h);
-					cairo_line_to (cr, x0 + (keyX + 0.025) * xs, y0 + 0.667 * h);
-					cairo_line_to (cr, x0 + (keyX + 0.025) * xs, y0 + h - 0.05 * xs);
-					cairo_arc_negative (cr, x0 + (keyX + 0.125) * xs, y0 + h - 0.1 * xs, 0.1 * xs, M_PI, M_PI / 2);
-					cairo_line_to (cr, x0 + (keyX + keyCoords[keyNrOffset].width - 0.125) * xs, y0 + h);
-					cairo_arc_negative (cr, x0 + (keyX + keyCoords[keyNrOffset].width - 0.125) * xs, y0 + h - 0.1 * xs, 0.1 * xs, M_PI / 2, 0);
-					cairo_line_to (cr, x0 + (keyX + keyCoords[keyNrOffset].width - 0.025) * xs, y0 + 0.667 * h);
-					cairo_line_to (cr, x0 + (keyX + keyCoords[keyNrOffset].width - keyCoords[keyNrOffset].dx2 - 0.025) * xs, y0 + 0.667 * h);
-					cairo_line_to (cr, x0 + (keyX + keyCoords[keyNrOffset].width - keyCoords[keyNrOffset].dx2 - 0.025) * xs, y0);
-					cairo_close_path (cr);
-					cairo_fill (cr);
-				}
-				else
-				{
-					const BStyles::Color color =
-					(
-						isActive(i) ?
-						(
-							getKey(i) != 0 ?
-							getFgColors()[getStatus()].illuminate (-0.5) :
-							getBgColors()[getStatus()].illuminate (-0.75)
-						) :
-						getBgColors()[getStatus()].illuminate (-0.5)
-					);
-
-					cairo_set_source_rgba (cr, CAIRO_RGBA (color));
-					cairoplus_rectangle_rounded (cr, x0 + keyX * xs, y0, keyCoords[keyNrOffset].width * xs, 0.6667 * h, 0.1 * xs, 0b1100);
-					cairo_fill (cr);
-				}
-
-			}
+			drawKeys (cr, area);
 			cairo_destroy (cr);
 		}
 	}
@@ -211,7 +211,7 @@ inline HScale::HScale	(const double  x, const double y, const double width, cons
 		Draggable(),
 		Scrollable()
 {
-
+	incremental_ = false;	// Own draw methods
 }
 
 inline Widget* HScale::clone () const 
@@ -0,0 +1,233 @@
+/* ItemSource.hpp
+ * Copyright (C) 2018 - 2022  Sven Jähnichen
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef BWIDGETS_ITEMSOURCE_HPP_
+#define BWIDGETS_ITEMSOURCE_HPP_
+
+#include "Label.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace BWidgets
+{
+
+/**
+ *  @brief  Interface for the items shown by SpinBox, ListBox, and ComboBox.
+ *
+ *  An %ItemSource provides the number of items and the text of each item.
+ *  Items are addressed by their position starting with 1. Position 0 is
+ *  reserved for the Null item (no selection) and is handled by the widgets
+ *  themselves.
+ *
+ *  The widgets don't create a widget per item. They only keep a small pool
+ *  of Label rows for the visible items and fill them on demand. Thus, an
+ *  %ItemSource may provide any number of items.
+ *
+ *  Each change of the items has to be followed by a call of @c changed() .
+ *  Data derived from the items (e.g., the type-ahead prefix index of
+ *  ListBox) is rebuilt if the revision changed.
+ */
+class ItemSource
+{
+protected:
+	uint64_t revision_;
+
+public:
+
+	ItemSource () : revision_ (0) {}
+
+	virtual ~ItemSource () {}
+
+	/**
+	 *  @brief  Marks the items as changed.
+	 */
+	void changed () {++revision_;}
+
+	/**
+	 *  @brief  Gets the revision of the items.
+	 *  @return  Revision. Changes upon each call of @c changed() .
+	 */
+	uint64_t getRevision () const {return revision_;}
+
+	/**
+	 *  @brief  Gets the number of items (without the Null item).
+	 *  @return  Number of items.
+	 */
+	virtual size_t getItemCount () const = 0;
+
+	/**
+	 *  @brief  Gets the text of an item.
+	 *  @param pos  Item position (1 .. @c getItemCount() ).
+	 *  @return  Item text.
+	 */
+	virtual std::string getItemText (const size_t pos) const = 0;
+
+	/**
+	 *  @brief  Gets the position of an item.
+	 *  @param item  Item text.
+	 *  @return  Position of the first item with the text @a item, or 0 if
+	 *  not found.
+	 */
+	virtual size_t findItem (const std::string& item) const
+	{
+		const size_t count = getItemCount();
+		for (size_t pos = 1; pos <= count; ++pos)
+		{
+			if (getItemText (pos) == item) return pos;
+		}
+		return 0;
+	}
+
+	/**
+	 *  @brief  Optional, adapts the Label row which shows an item.
+	 *  @param pos  Item position (1 .. @c getItemCount() ).
+	 *  @param label  Label row. The text is already set.
+	 *
+	 *  Label rows are recycled. Thus, all properties changed here have to be
+	 *  set for each item.
+	 */
+	virtual void formatItem (const size_t pos, Label* label) const {}
+};
+
+/**
+ *  @brief  Default ItemSource storing the item texts in a vector.
+ *
+ *  Access by position is O(1). Access by text (@c findItem() ) uses a hash
+ *  map from the item text to the position. Appending items and deleting the
+ *  last item keep the hash map up to date. Insertion or deletion at other
+ *  positions invalidate the hash map. It is rebuilt upon the next call of
+ *  @c findItem() .
+ */
+class ItemList : public ItemSource
+{
+protected:
+	std::vector<std::string> items_;
+	mutable std::unordered_map<std::string, size_t> index_;	// Text to position of the first item
+	mutable bool indexed_;
+
+public:
+
+	/**
+	 *  @brief  Constructs an empty %ItemList.
+	 */
+	ItemList () : items_ (), index_ (), indexed_ (true) {}
+
+	/**
+	 *  @brief  Constructs an %ItemList.
+	 *  @param items  Initializer list of item strings.
+	 */
+	ItemList (const std::initializer_list<const std::string> items) : 
+		items_ (items.begin(), items.end()), 
+		index_ (), 
+		indexed_ (false) 
+	{
+
+	}
+
+	virtual size_t getItemCount () const override
+	{
+		return items_.size();
+	}
+
+	virtual std::string getItemText (const size_t pos) const override
+	{
+		return ((pos >= 1) && (pos <= items_.size()) ? items_[pos - 1] : "");
+	}
+
+	virtual size_t findItem (const std::string& item) const override
+	{
+		if (!indexed_)
+		{
+			index_.clear();
+			index_.reserve (items_.size());
+			for (size_t i = 0; i < items_.size(); ++i) index_.emplace (items_[i], i + 1);
+			indexed_ = true;
+		}
+
+		std::unordered_map<std::string, size_t>::const_iterator it = index_.find (item);
+		return (it != index_.end() ? it->second : 0);
+	}
+
+	/**
+	 *  @brief  Inserts an item.
+	 *  @param item  Item text.
+	 *  @param pos  Position of the item to be inserted before (pos >= 1).
+	 *  Positions behind the last item append the item.
+	 */
+	void insert (const std::string& item, const size_t pos)
+	{
+		if (pos > items_.size()) 
+		{
+			items_.push_back (item);
+			if (indexed_) index_.emplace (item, items_.size());
+		}
+
+		else 
+		{
+			items_.insert (items_.begin() + (pos >= 1 ? pos - 1 : 0), item);
+			indexed_ = false;
+		}
+
+		changed();
+	}
+
+	/**
+	 *  @brief  Deletes an item.
+	 *  @param pos  Item position (1 .. @c getItemCount() ).
+	 */
+	void erase (const size_t pos)
+	{
+		if ((pos < 1) || (pos > items_.size())) return;
+
+		if (pos == items_.size())
+		{
+			if (indexed_)
+			{
+				std::unordered_map<std::string, size_t>::iterator it = index_.find (items_.back());
+				if ((it != index_.end()) && (it->second == pos)) index_.erase (it);
+			}
+			items_.pop_back();
+		}
+
+		else
+		{
+			items_.erase (items_.begin() + (pos - 1));
+			indexed_ = false;
+		}
+
+		changed();
+	}
+
+	/**
+	 *  @brief  Deletes all items.
+	 */
+	void clear ()
+	{
+		items_.clear();
+		index_.clear();
+		indexed_ = true;
+		changed();
+	}
+};
+
+}
+
+#endif /* BWIDGETS_ITEMSOURCE_HPP_ */
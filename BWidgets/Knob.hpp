@@ -49,6 +49,17 @@ class Knob : public Button
 protected:
 	double depth_;
 
+	struct StaticKnob
+	{
+		cairo_surface_t* surface;
+		BUtilities::Area<> area;
+		double depth;
+		BStyles::Color color;
+		BStyles::Color bgColor;
+	};
+
+	StaticKnob staticKnobs_[2];
+
 public:
 
 	/**
@@ -90,6 +101,8 @@ public:
 			 const double depth = 1.0, bool toggleable = false, bool clicked = false,
 			 uint32_t urid = URID_UNKNOWN_URID, std::string title = "");
 
+	virtual ~Knob();
+
 	/**
 	 *  @brief  Creates a clone of the %Knob. 
 	 *  @return  Pointer to the new %Knob.
@@ -129,6 +142,21 @@ public:
 
 protected:
 	/**
+	 *  @brief  Renders a %Knob to one of the two static surfaces.
+	 *  @param value  Value (released / pressed) to render.
+	 *  @param area  Effective area of the knob.
+	 *  @param depth  Pseudo 3D depth.
+	 *  @param color  Knob RGBA color.
+	 *  @param bgColor  Background RGBA color.
+	 *
+	 *  A %Knob only toggles between two appearances. Both are kept as
+	 *  static surfaces and blitted on each draw. A static surface is only
+	 *  re-rendered if the widget extends or one of the parameters changed.
+	 */
+	void drawStatic	(const bool value, const BUtilities::Area<>& area, const double depth, 
+					 const BStyles::Color& color, const BStyles::Color& bgColor);
+
+	/**
      *  @brief  Unclipped draw a %Knob to the surface.
      */
     virtual void draw () override;
@@ -169,12 +197,22 @@ inline Knob::Knob (const double depth, bool toggleable, bool clicked, uint32_t u
 
 inline Knob::Knob (const double  x, const double y, const double width, const double height, double depth, bool toggleable, bool clicked, uint32_t urid, std::string title) :
 		Button (x, y, width, height, toggleable, clicked, urid, title),
-		depth_ (depth)
+		depth_ (depth),
+		staticKnobs_ {{nullptr, BUtilities::Area<>(), 0.0, BStyles::Color(), BStyles::Color()},
+					  {nullptr, BUtilities::Area<>(), 0.0, BStyles::Color(), BStyles::Color()}}
 {
 	setBackground (BStyles::noFill);
 	setBorder (BStyles::noBorder);
 }
 
+inline Knob::~Knob()
+{
+	for (StaticKnob& k : staticKnobs_)
+	{
+		if (k.surface) cairo_surface_destroy (k.surface);
+	}
+}
+
 inline Widget* Knob::clone () const 
 {
 	Widget* f = new Knob (urid_, title_);
@@ -185,6 +223,11 @@ inline Widget* Knob::clone () const
 inline void Knob::copy (const Knob* that)
 {
 	depth_ = that->depth_;
+	for (StaticKnob& k : staticKnobs_)
+	{
+		if (k.surface) cairo_surface_destroy (k.surface);
+		k.surface = nullptr;
+	}
     Widget::copy (that);
 }
 
@@ -213,6 +256,42 @@ inline double Knob::getDepth () const
 	return depth_;
 }
 
+inline void Knob::drawStatic	(const bool value, const BUtilities::Area<>& area, const double depth, 
+								 const BStyles::Color& color, const BStyles::Color& bgColor)
+{
+	StaticKnob& k = staticKnobs_[value ? 1 : 0];
+
+	if
+	(
+		k.surface &&
+		(cairo_image_surface_get_width (k.surface) == cairo_image_surface_get_width (surface_)) &&
+		(cairo_image_surface_get_height (k.surface) == cairo_image_surface_get_height (surface_)) &&
+		(k.area == area) &&
+		(k.depth == depth) &&
+		(k.color == color) &&
+		(k.bgColor == bgColor)
+	) return;
+
+	if (k.surface) cairo_surface_destroy (k.surface);
+	k.surface = cairo_image_surface_create (CAIRO_FORMAT_ARGB32, getWidth(), getHeight());
+	k.area = area;
+	k.depth = depth;
+	k.color = color;
+	k.bgColor = bgColor;
+
+	if (cairo_surface_status (k.surface) != CAIRO_STATUS_SUCCESS) return;
+	cairo_t* cr = cairo_create (k.surface);
+	if (cairo_status (cr) == CAIRO_STATUS_SUCCESS)
+	{
+		// Calculate aspect ratios first
+		const double radius = (area.getHeight() < area.getWidth() ? 0.5 * area.getHeight() : 0.5 * area.getWidth()) - depth_;
+		const double xc = area.getX() + 0.5 * area.getWidth() + depth_;
+		const double yc = area.getY() + 0.5 * area.getHeight() + depth_;
+		drawKnob(cr, xc, yc, radius, depth, color, bgColor);
+	}
+	cairo_destroy (cr);
+}
+
 inline void Knob::draw ()
 {
 	draw (0, 0, getWidth(), getHeight());
@@ -247,14 +326,17 @@ inline void Knob::draw (const BUtilities::Area<>& area)
 			cairo_rectangle (cr, area.getX (), area.getY (), area.getWidth (), area.getHeight ());
 			cairo_clip (cr);
 
-			// Calculate aspect ratios first
-			const double radius = (heff < weff ? 0.5 * heff : 0.5 * weff) - depth_;
-			const double xc = x0 + 0.5 * weff + depth_;
-			const double yc = y0 + 0.5 * heff + depth_;
-
 			const BStyles::Color color = (getValue() ? getFgColors() : getBgColors()) [getStatus()];
 			const double depth = (getValue() ? 0.5 * depth_ : depth_);
-			drawKnob(cr, xc, yc, radius, depth, color, getBgColors()[getStatus()]);
+			drawStatic (getValue(), BUtilities::Area<> (x0, y0, weff, heff), depth, color, getBgColors()[getStatus()]);
+
+			// Blit knob
+			const StaticKnob& k = staticKnobs_[getValue() ? 1 : 0];
+			if (k.surface && (cairo_surface_status (k.surface) == CAIRO_STATUS_SUCCESS))
+			{
+				cairo_set_source_surface (cr, k.surface, 0, 0);
+				cairo_paint (cr);
+			}
 		}
 
 		cairo_destroy (cr);
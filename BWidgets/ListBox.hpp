@@ -20,10 +20,17 @@
 
 #include "SpinBox.hpp"
 #include "Supports/Clickable.hpp"
+#include "Supports/KeyPressable.hpp"
 #include "../BEvents/PointerEvent.hpp"
+#include "../BEvents/KeyEvent.hpp"
+#include "../BUtilities/PrefixIndex.hpp"
 #include "VScrollBar.hpp"
+#include "Window.hpp"
 #include "Widget.hpp"
-#include <iterator>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
 
 #ifndef BWIDGETS_DEFAULT_LISTBOX_WIDTH
 #define BWIDGETS_DEFAULT_LISTBOX_WIDTH 80.0
@@ -45,11 +52,33 @@ namespace BWidgets
  *  an item by the support of Clickable. The selected item is turned in its
  *  active state.
  *
+ *  All items have got the same height. Only the rows for the visible items
+ *  are allocated. Thus, the costs for scrolling and updating depend on the
+ *  %ListBox height and not on the number of items.
+ *
+ *  %ListBox supports type-ahead search (KeyPressable). Clicking on the
+ *  %ListBox grabs the keyboard. Typed characters narrow the shown items to
+ *  the items starting with the typed text (case-insensitive). Backspace
+ *  removes the last character, Enter selects the first shown item and
+ *  releases the keyboard, and Escape resets the filter and releases the
+ *  keyboard. The keyboard is also released if the %ListBox loses the
+ *  pointer focus. The search uses a
+ *  sorted prefix index which is only rebuilt if the items changed (see
+ *  @c ItemSource::changed() ).
+ *
  *  @todo  Resize()
  *  @todo  Import item widgets.
  */
-class ListBox : public SpinBox
+class ListBox : public SpinBox, public KeyPressable
 {
+protected:
+	std::string filter_;
+	std::vector<size_t> view_;				// Item positions shown if filtered
+	BUtilities::PrefixIndex prefixIndex_;
+	const ItemSource* indexSource_;			// Source and revision of prefixIndex_
+	uint64_t indexRevision_;
+	bool viewValid_;
+
 public:
 
 	/**
@@ -121,6 +150,40 @@ public:
 	 */
 	virtual void setTop (const size_t pos);
 
+	/**
+	 *  @brief  Gets the visualized list top index.
+	 *  @return  Index of the item on list top position.
+	 */
+	size_t getTop () const;
+
+	/**
+	 *  @brief  Shows only the items starting with a text.
+	 *  @param filter  Text (case-insensitive), or "" to show all items.
+	 *
+	 *  The visualized list indices (see @c setTop() ) refer to the shown
+	 *  items. The widget value still refers to the item index.
+	 */
+	void setFilter (const std::string& filter);
+
+	/**
+	 *  @brief  Gets the type-ahead filter text.
+	 *  @return  Filter text.
+	 */
+	std::string getFilter () const;
+
+	/**
+	 *  @brief  Gets the number of shown items (without the Null item).
+	 *  @return  Number of shown items.
+	 */
+	size_t getViewCount () const;
+
+	/**
+	 *  @brief  Gets the item index of a shown item.
+	 *  @param pos  Visualized list index.
+	 *  @return  Item index.
+	 */
+	size_t getViewItem (const size_t pos) const;
+
 	/**
      *  @brief  Method called when pointer button pressed.
      *  @param event  Passed Event.
@@ -141,8 +204,43 @@ public:
      */
     virtual void onWheelScrolled (BEvents::Event* event) override;
 
+	/**
+     *  @brief  Method called when a key is pressed.
+     *  @param event  Passed Event.
+     *
+     *  Overridable method called from the main window event scheduler if a
+     *  key is pressed. Edits the type-ahead filter and calls the static
+	 *  callback function.
+     */
+	virtual void onKeyPressed (BEvents::Event* event) override;
+
+	/**
+     *  @brief  Method called when a key is released.
+     *  @param event  Passed Event.
+     *
+     *  Overridable method called from the main window event scheduler if a
+     *  key is released. Calls the static callback function.
+     */
+	virtual void onKeyReleased (BEvents::Event* event) override;
+
+	/**
+     *  @brief  Method called when pointer focus out.
+     *  @param event  Passed Event.
+     *
+     *  Overridable method called from the main window event scheduler if the
+     *  pointer focus is lost. Releases the keyboard and calls the static
+	 *  callback function.
+     */
+	virtual void onFocusOut (BEvents::Event* event) override;
+
 protected:
 
+	/**
+	 *  @brief  Rebuilds the list of shown items if the filter or the items
+	 *  changed.
+	 */
+	void updateView ();
+
 	/**
 	 *  @brief  Callback function which handles and forwards 
 	 *  VALUE_CHANGED_EVENTs from the SpinButton.
@@ -161,7 +259,14 @@ inline ListBox::ListBox	(const std::initializer_list<const std::string> items, s
 
 inline ListBox::ListBox	(const double x, const double y, const double width, const double height, 
 			 	 		 std::initializer_list<const std::string> items, size_t value, uint32_t urid, std::string title) :
-	SpinBox (x, y, width, height, items, value, urid, title)
+	SpinBox (x, y, width, height, items, value, urid, title),
+	KeyPressable (),
+	filter_ (),
+	view_ (),
+	prefixIndex_ (),
+	indexSource_ (nullptr),
+	indexRevision_ (0),
+	viewValid_ (false)
 {
 	buttonWidth_ = 0.5 * BWIDGETS_DEFAULT_SPINBOX_BUTTON_WIDTH;
 	if (button_) delete button_;
@@ -172,7 +277,6 @@ inline ListBox::ListBox	(const double x, const double y, const double width, con
 	button_->setCallbackFunction(BEvents::Event::VALUE_CHANGED_EVENT, ListBox::valueChangedCallback);
 	add (button_);
 	itemHeight_ = BWIDGETS_DEFAULT_SPINBOX_ITEM_HEIGHT;
-	for (Widget* w : items_) w->setHeight (itemHeight_);
 }
 
 inline Widget* ListBox::clone () const 
@@ -184,6 +288,12 @@ inline Widget* ListBox::clone () const
 
 inline void ListBox::copy (const ListBox* that)
 {
+	filter_ = that->filter_;
+	view_.clear();
+	prefixIndex_.clear();
+	indexSource_ = nullptr;
+	viewValid_ = false;
+	KeyPressable::operator= (*that);
 	SpinBox::copy (that);
 }
 
@@ -196,74 +306,117 @@ inline void ListBox::setTop (const size_t pos)
 	}
 }
 
+inline size_t ListBox::getTop () const
+{
+	return top_;
+}
+
+inline void ListBox::setFilter (const std::string& filter)
+{
+	if (filter != filter_)
+	{
+		filter_ = filter;
+		viewValid_ = false;
+		updateView();
+		top_ = (getViewCount() > 0 ? 1 : 0);
+		update();
+	}
+}
+
+inline std::string ListBox::getFilter () const
+{
+	return filter_;
+}
+
+inline size_t ListBox::getViewCount () const
+{
+	return (filter_ == "" ? getItemCount() : view_.size());
+}
+
+inline size_t ListBox::getViewItem (const size_t pos) const
+{
+	if (pos == 0) return 0;
+	if (filter_ == "") return pos;
+	return (pos <= view_.size() ? view_[pos - 1] : 0);
+}
+
+inline void ListBox::updateView ()
+{
+	if (filter_ == "") return;
+
+	// Rebuild prefix index if items changed
+	if ((indexSource_ != source_) || (indexRevision_ != source_->getRevision()))
+	{
+		const size_t count = getItemCount();
+		prefixIndex_.clear();
+		prefixIndex_.reserve (count);
+		for (size_t i = 1; i <= count; ++i) prefixIndex_.add (source_->getItemText (i), i);
+		prefixIndex_.build();
+		indexSource_ = source_;
+		indexRevision_ = source_->getRevision();
+		viewValid_ = false;
+	}
+
+	// Narrow to the items starting with filter_, in list order
+	if (!viewValid_)
+	{
+		std::pair<BUtilities::PrefixIndex::const_iterator, BUtilities::PrefixIndex::const_iterator> range = prefixIndex_.find (filter_);
+		view_.clear();
+		for (BUtilities::PrefixIndex::const_iterator it = range.first; it != range.second; ++it) view_.push_back (it->second);
+		std::sort (view_.begin(), view_.end());
+		viewValid_ = true;
+	}
+}
+
 inline void ListBox::update ()
 {
-	size_t count = 0;
-	double tHeight = 0.0;
-	double lHeight = 0.0;
-	for (std::list<Widget*>::iterator it = items_.begin(); it != items_.end(); ++it)
+	updateView ();
+	const size_t total = getViewCount() + 1;	// Incl. Null item
+	if (top_ >= total) top_ = total - 1;
+
+	// Allocate rows for the ListBox area
+	const size_t nrRows = (itemHeight_ > 0.0 ? std::ceil (std::max (getEffectiveHeight(), 0.0) / itemHeight_) : 0);
+	allocateRows (nrRows);
+
+	// Fill rows with items from top_
+	size_t nrVisible = 0;
+	for (size_t i = 0; i < rows_.size(); ++i)
 	{
-		Widget* w = *it;
-		if (w)
+		Label* l = rows_[i];
+		const size_t pos = getViewItem (top_ + i);
+		if (top_ + i >= total)
+		{
+			l->hide();
+			continue;
+		}
+
+		fillRow (l, pos);
+		l->moveTo (getXOffset(), getYOffset() + i * itemHeight_);
+		l->resize (getEffectiveWidth() - buttonWidth_, itemHeight_);
+
+		if (getValue() == pos) 
+		{
+			l->setStatus (BStyles::STATUS_ACTIVE);
+			l->setBackground (BStyles::Fill (getBgColors()[BStyles::STATUS_NORMAL].illuminate (BStyles::Color::darkened)));
+		}
+		else 
 		{
-			// Items before top_
-			// Set negative y positions
-			if ((count == top_) && (it != items_.begin()))
-			{
-				double mtHeight = 0.0;
-				for (std::list<Widget*>::iterator it2 = std::prev (it); /* empty */; --it2)
-				{
-					Widget* w2 = *it2;
-					mtHeight -= w2->getHeight();
-					w2->moveTo (getXOffset(), getYOffset() + mtHeight);
-					w2->setWidth(getEffectiveWidth() - buttonWidth_);
-					if (it2 == items_.begin()) break;
-				}
-			}
-
-			// Items from top_ to the end of the ListBox area
-			if (count >= top_)
-			{
-				w->moveTo (getXOffset(), getYOffset() + tHeight);
-				w->setWidth(getEffectiveWidth() - buttonWidth_);
-				if (tHeight < getEffectiveHeight()) 
-				{
-					w->show();
-					lHeight = w->getPosition().y + w->getHeight();
-				}
-				else w->hide();
-				tHeight += w->getHeight();
-			}
-
-			// Items outside the ListBox area
-			else w->hide();
-
-			if (getValue() == count) 
-			{
-				w->setStatus (BStyles::STATUS_ACTIVE);
-				w->setBackground (BStyles::Fill (getBgColors()[BStyles::STATUS_NORMAL].illuminate (BStyles::Color::darkened)));
-			}
-			else 
-			{
-				w->setStatus (BStyles::STATUS_NORMAL);
-				w->setBackground (BStyles::noFill);
-			}
+			l->setStatus (BStyles::STATUS_NORMAL);
+			l->setBackground (BStyles::noFill);
 		}
-		++count;
+
+		l->show();
+		++nrVisible;
 	}
 
 	button_->moveTo (getEffectiveWidth() + getXOffset() - buttonWidth_, getYOffset());
 	button_->resize (buttonWidth_, getEffectiveHeight());
-	
-	const double y0 = items_.front()->getPosition().y;
-	const double ye = items_.back()->getPosition().y + items_.back()->getHeight();
-	std::list<Widget*>::iterator it = std::next (items_.begin(), top_);
-	const double y = (*it)->getPosition().y + 0.5 * (*it)->getHeight();
+
 	VScrollBar* vs = dynamic_cast<VScrollBar*>(button_);
-	if (vs && (ye > y0)) 
+	if (vs) 
 	{
-		vs->setValue ((y - y0) / (ye - y0));
-		vs->setValueSize ((lHeight - y) / (ye - y0));
+		vs->setValue ((double (top_) + 0.5) / double (total));
+		vs->setValueSize ((double (nrVisible) - 0.5) / double (total));
 	};
 
 	Widget::update();
@@ -274,23 +427,17 @@ inline void ListBox::onButtonPressed (BEvents::Event* event)
 	BEvents::PointerEvent* pev = dynamic_cast<BEvents::PointerEvent*>(event);
 	if (!pev) return;
 	if (pev->getWidget() != this) return;
+	if (itemHeight_ <= 0.0) return;
 
-	size_t count = top_;
-	for (std::list<Widget*>::iterator it = std::next(items_.begin(), top_); it != items_.end(); ++it)
-	{
-		Widget* w = *it;
-		const double bottom = getYOffset() + w->getPosition().y + w->getHeight();
+	const double y = pev->getPosition().y - getYOffset();
+	if (y >= getEffectiveHeight()) return;
 
-		if (pev->getPosition().y < bottom) 
-		{
-			setValue (count);
-			break;
-		}
+	// Type-ahead
+	Window* window = dynamic_cast<Window*>(main_);
+	if (window && isKeyPressable()) window->getKeyGrabStack()->add (this);
 
-		if (bottom > getYOffset() + getEffectiveHeight()) break;
-		
-		++count;
-	}
+	const size_t pos = top_ + size_t (std::max (y, 0.0) / itemHeight_);
+	if (pos <= getViewCount()) setValue (getViewItem (pos));
 }
 
 inline void ListBox::onWheelScrolled (BEvents::Event* event)
@@ -300,7 +447,7 @@ inline void ListBox::onWheelScrolled (BEvents::Event* event)
 	if (wev->getWidget() != this) return;
 
 	if	(((top_ > 1) || (wev->getDelta().y < 0)) &&
-		 ((top_ + 1 < items_.size()) || (wev->getDelta().y > 0)))
+		 ((top_ < getViewCount()) || (wev->getDelta().y > 0)))
 	{
 		setTop (top_ - (wev->getDelta().y < 0 ? -1 : (wev->getDelta().y > 0 ? 1 : 0)));
 	}
@@ -308,6 +455,85 @@ inline void ListBox::onWheelScrolled (BEvents::Event* event)
 	Scrollable::onWheelScrolled(event);
 }
 
+inline void ListBox::onKeyPressed (BEvents::Event* event)
+{
+	BEvents::KeyEvent* kev = dynamic_cast<BEvents::KeyEvent*>(event);
+	Window* window = dynamic_cast<Window*>(main_);
+	if	(
+			kev && 
+			(kev->getWidget() == this) && 
+			window && 
+			window->getKeyGrabStack()->getGrab(0) && 
+			(window->getKeyGrabStack()->getGrab(0)->getWidget() == this)
+		)
+	{
+		const uint32_t key = kev->getKey();
+
+		switch (key)
+		{
+			// Backspace: Remove last (UTF-8) character
+			case 8:		if (filter_ != "")
+						{
+							size_t len = filter_.size() - 1;
+							while ((len > 0) && ((filter_[len] & 0xC0) == 0x80)) --len;
+							setFilter (filter_.substr (0, len));
+						}
+						break;
+
+			// Enter: Select first shown item and release keyboard
+			case 13:	window->getKeyGrabStack()->remove (this);
+						if (getViewCount() > 0) setValue (getViewItem (1));
+						break;
+
+			// Escape: Reset and release keyboard
+			case 27:	window->getKeyGrabStack()->remove (this);
+						setFilter ("");
+						break;
+
+			default:	if ((key >= 0x20) && (key != 0x7F) && ((key < PUGL_KEY_F1) || (key > PUGL_KEY_PAUSE)))
+						{
+							std::string s = filter_;
+							if (key < 0x80) s += char (key);
+							else if (key < 0x800) 
+							{
+								s += char (0xC0 | (key >> 6));
+								s += char (0x80 | (key & 0x3F));
+							}
+							else if (key < 0x10000)
+							{
+								s += char (0xE0 | (key >> 12));
+								s += char (0x80 | ((key >> 6) & 0x3F));
+								s += char (0x80 | (key & 0x3F));
+							}
+							else
+							{
+								s += char (0xF0 | (key >> 18));
+								s += char (0x80 | ((key >> 12) & 0x3F));
+								s += char (0x80 | ((key >> 6) & 0x3F));
+								s += char (0x80 | (key & 0x3F));
+							}
+							setFilter (s);
+						}
+						break;
+		}
+	}
+
+	callback (BEvents::Event::EventType::KEY_PRESS_EVENT) (event);
+}
+
+inline void ListBox::onKeyReleased (BEvents::Event* event)
+{
+	callback (BEvents::Event::EventType::KEY_RELEASE_EVENT) (event);
+}
+
+inline void ListBox::onFocusOut (BEvents::Event* event)
+{
+	Window* window = dynamic_cast<Window*>(main_);
+	if (event && (event->getWidget() == this) && window) window->getKeyGrabStack()->remove (this);
+
+	SpinBox::onFocusOut (event);
+}
+
 inline void ListBox::valueChangedCallback (BEvents::Event* event)
 {
 	BEvents::ValueChangeTypedEvent<double>* vev = dynamic_cast<BEvents::ValueChangeTypedEvent<double>*>(event);
@@ -319,26 +545,14 @@ inline void ListBox::valueChangedCallback (BEvents::Event* event)
 
 	if	(w == p->button_)
 	{
-		std::list<Widget*>::iterator bit = (p->items_.size() > 1 ? std::next (p->items_.begin()) : p->items_.begin());
-		const double y0 = p->items_.front()->getPosition().y;
-		const double ye = p->items_.back()->getPosition().y + p->items_.back()->getHeight();
-		if (y0 < ye)
-		{
-			const double y = y0 + w->getValue() * (ye - y0);
-			size_t count = (p->items_.size() > 1 ? 1 : 0);
-			for (std::list<Widget*>::iterator it = bit; it != p->items_.end(); ++it)
-			{
-				Widget* w2 = (*it);
-				if (y <= w2->getPosition().y + w2->getHeight())
-				{
-					w->setValueable (false);
-					p->setTop (count);
-					w->setValueable (true);
-					break;
-				} 
-				++count;
-			}
-		}
+		// First item with its bottom below the scrollbar position
+		const size_t total = p->getViewCount() + 1;
+		const double y = std::ceil (w->getValue() * double (total)) - 1.0;
+		const size_t first = (total > 1 ? 1 : 0);
+		const size_t pos = std::min (std::max (size_t (std::max (y, 0.0)), first), total - 1);
+		w->setValueable (false);
+		p->setTop (pos);
+		w->setValueable (true);
 	}
 }
 
@@ -25,10 +25,17 @@
 #include "Supports/ValueTransferable.hpp"
 #include "Supports/ValueableTyped.hpp"
 #include "../BEvents/PointerEvent.hpp"
+#include "../BEvents/ValueChangeDeltaEvent.hpp"
+#include "../BUtilities/Journal.hpp"
 #include <cairo/cairo.h>
+#include <algorithm>
+#include <cmath>
 #include <cstddef>
+#include <map>
 #include <string>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
 #ifndef BWIDGETS_DEFAULT_PATTERN_WIDTH
 #define BWIDGETS_DEFAULT_PATTERN_WIDTH 400
@@ -38,6 +45,10 @@
 #define BWIDGETS_DEFAULT_PATTERN_HEIGHT 200
 #endif
 
+#ifndef BWIDGETS_DEFAULT_PATTERN_PAD_CACHE_SIZE
+#define BWIDGETS_DEFAULT_PATTERN_PAD_CACHE_SIZE 64
+#endif
+
 namespace BWidgets
 {
 /**
@@ -72,9 +83,34 @@ namespace BWidgets
  *  pad extends (default: BUtilities::Point<size_t>(0, 0)) as the first and 
  *  the respective pad value as the second type.
  *
+ *  In the flyweight mode (see @c setFlyweight() ), %Pattern doesn't create
+ *  a pad widget for each pad. Instead, it keeps all pad values in a single
+ *  contiguous array and draws the pads itself to its own surface using a
+ *  single, unlinked pad widget as a prototype (see @c getPadPrototype() ).
+ *  Pads with the same value are rendered only once and then copied from a
+ *  cache. Value changes only mark the respective pads as damaged and only
+ *  the damaged pads are redrawn. Thus, even large patterns only cost a 
+ *  single widget and a single surface. @c getPad() returns nullptr in the
+ *  flyweight mode.
+ *
+ *  Value changes are emitted as ValueChangeDeltaEvent<PadChange, value_type>
+ *  which is a ValueChangeTypedEvent<value_type> and additionally contains
+ *  the changed pads (column, row, value). Bulk operations
+ *  (e. g., @c pasteValues() ) and changes enclosed by @c beginChange() and
+ *  @c endChange() are emitted as a single event. Use @c getValue() or
+ *  @c getPadValue() to get the resulting values. The value is shared with
+ *  the emitted events (copy-on-write). It is only copied if an event still
+ *  holds the previously emitted value. Otherwise only the changed pads are
+ *  updated.
+ *
+ *  All pad value changes are recorded in a Journal and can be undone
+ *  (@c undo() ) and redone (@c redo() ). Each bulk operation, each batch
+ *  (see @c beginChange() ), and all changes from pressing until releasing
+ *  a button (e. g., a drag stroke) form a single action. Only the changed
+ *  pads are stored.
+ *
  *  @todo  Support change pattern size.
  *  @todo  Support merge pads by dragging.
- *  @todo  Support Journal.
  */
 template <class T = Pad<>>
 class Pattern : public Widget, 
@@ -87,6 +123,16 @@ public:
 
 	typedef std::vector<std::vector<std::pair<BUtilities::Point<size_t>, typename T::value_type>>> value_type;
 
+	/**
+	 *  @brief  Change of a single pad value.
+	 */
+	struct PadChange
+	{
+		size_t column;
+		size_t row;
+		typename T::value_type value;
+	};
+
 protected:
 
 	/**
@@ -166,6 +212,21 @@ protected:
     	virtual void setReTransferFunction (std::function<typename T::value_type (const typename T::value_type& x)> func) override;
 	};
 
+	/**
+	 *  @brief  Pad widget used as prototype to render pads in the flyweight 
+	 *  mode.
+	 */
+	class PadRenderer : public T
+	{
+	public:
+		PadRenderer (const uint32_t urid, const std::string& title) : T (urid, title) {}
+
+		/**
+		 *  @brief  Draws the whole pad to its surface.
+		 */
+		void render () {this->draw();}
+	};
+
 public:
 
 	/**
@@ -198,6 +259,21 @@ protected:
 	EditMode editMode_;
 	bool allowYMerge_;
 	value_type clipBoard_;
+	bool flyweight_;
+	std::vector<typename T::value_type> cells_;	// Flyweight mode: pad values, row by row
+	std::vector<size_t> damage_;				// Flyweight mode: indexes of damaged pads
+	std::vector<bool> damaged_;
+	bool fullDraw_;
+	PadRenderer* prototype_;
+	std::map<typename T::value_type, cairo_surface_t*> padCache_;
+	std::unordered_map<const Widget*, size_t> padIndex_;	// Pad widget to index (row * columns_ + column)
+	std::vector<PadChange> changes_;						// Not yet emitted changes
+	bool extentsChanged_;									// Not yet emitted pad extents change
+	std::shared_ptr<value_type> shared_;					// Value shared with emitted events (copy-on-write)
+	int batch_;
+	BUtilities::Journal<size_t, typename T::value_type> journal_;
+	bool replaying_;	// Undo or redo in progress, don't record
+	bool stroke_;		// Journal action opened by a button press
 
 
 private:
@@ -225,8 +301,11 @@ public:
 	 *  @param rows  Number of rows.
 	 *  @param urid  Optional, URID (default = URID_UNKNOWN_URID).
 	 *  @param title  Optional, %Widget title (default = "").
+	 *  @param flyweight  Optional, true for the flyweight mode (default = 
+	 *  false).
 	 */
-	Pattern	(const size_t columns, const size_t rows, uint32_t urid = URID_UNKNOWN_URID, std::string title = "");
+	Pattern	(const size_t columns, const size_t rows, uint32_t urid = URID_UNKNOWN_URID, std::string title = "",
+			 const bool flyweight = false);
 
 	/**
 	 *  @brief  Creates a %Pattern.
@@ -238,10 +317,13 @@ public:
 	 *  @param rows  Number of rows.
 	 *  @param urid  Optional, URID (default = URID_UNKNOWN_URID).
 	 *  @param title  Optional, %Widget title (default = "").
+	 *  @param flyweight  Optional, true for the flyweight mode (default = 
+	 *  false).
 	 */
 	Pattern	(const double x, const double y, const double width, const double height, 
 			 const size_t columns, const size_t rows,
-			 uint32_t urid = URID_UNKNOWN_URID, std::string title = "");
+			 uint32_t urid = URID_UNKNOWN_URID, std::string title = "",
+			 const bool flyweight = false);
 
 	~Pattern();
 
@@ -265,6 +347,93 @@ public:
 	 */
 	void copy (const Pattern* that);
 
+	/**
+	 *  @brief  Changes the value of the %Pattern.
+	 *  @param value  New value.
+	 *
+	 *  Also sets the values of the pads. Emits a single
+	 *  ValueChangeDeltaEvent with the changed pads.
+	 */
+	virtual void setValue (const value_type& value) override;
+
+	/**
+	 *  @brief  Changes the value of the %Pattern.
+	 *  @param value  New value.
+	 *
+	 *  Equivalent to @c setValue(const value_type&) .
+	 */
+	virtual void setValue (value_type&& value) override;
+
+	using ValueableTyped<value_type>::setValue;
+
+	/**
+	 *  @brief  Switches the flyweight mode on or off.
+	 *  @param flyweight  True for the flyweight mode, false for a pad widget
+	 *  for each pad.
+	 *
+	 *  The pad values are kept. Pad widgets are (re-)created or deleted,
+	 *  respectively.
+	 */
+	void setFlyweight (const bool flyweight);
+
+	/**
+	 *  @brief  Checks if the flyweight mode is on.
+	 *  @return  True if on, otherwise false.
+	 */
+	bool isFlyweight () const;
+
+	/**
+	 *  @brief  Sets the value of a single pad.
+	 *  @param column  %Pattern column (starting with 0). 
+	 *  @param row  %Pattern row (starting with 0).
+	 *  @param value  New pad value.
+	 */
+	void setPadValue (const size_t column, const size_t row, const typename T::value_type& value);
+
+	/**
+	 *  @brief  Gets the value of a single pad.
+	 *  @param column  %Pattern column (starting with 0). 
+	 *  @param row  %Pattern row (starting with 0).
+	 *  @return  Pad value.
+	 */
+	typename T::value_type getPadValue (const size_t column, const size_t row) const;
+
+	/**
+	 *  @brief  Starts a batch of pad value changes.
+	 *
+	 *  All following changes are collected and emitted as a single
+	 *  ValueChangeDeltaEvent upon the matching call of @c endChange() .
+	 *  Batches may be nested.
+	 */
+	void beginChange ();
+
+	/**
+	 *  @brief  Ends a batch of pad value changes and emits the changes.
+	 */
+	void endChange ();
+
+	/**
+	 *  @brief  Undoes the last action.
+	 *  @return  True if an action was undone, otherwise false.
+	 */
+	bool undo ();
+
+	/**
+	 *  @brief  Redoes the last undone action.
+	 *  @return  True if an action was redone, otherwise false.
+	 */
+	bool redo ();
+
+	/**
+	 *  @brief  Gets access to the journal of pad value changes.
+	 *  @return  Reference to the Journal. Keys are the pad indexes 
+	 *  (row * columns + column).
+	 *
+	 *  Can be used to check for possible undo / redo, to clear the journal
+	 *  or to change its maximum size.
+	 */
+	BUtilities::Journal<size_t, typename T::value_type>& getJournal ();
+
 	/**
 	 *  @brief  Changes the edit mode.
 	 *  @param editMode  EditMode.
@@ -334,10 +503,21 @@ public:
 	 *  @brief  Gets the Wigget for the respective pad.
 	 *  @param column  %Pattern column (starting with 0). 
 	 *  @param row  %Pattern row (starting with 0).
-	 *  @return  Pointer to the Widget for the respective pad.
+	 *  @return  Pointer to the Widget for the respective pad, or nullptr in 
+	 *  the flyweight mode.
 	 */
 	Widget* getPad (const size_t column, const size_t row) const;
 
+	/**
+	 *  @brief  Gets the pad widget used to render the pads in the flyweight
+	 *  mode.
+	 *  @return  Pointer to the prototype pad widget.
+	 *
+	 *  The prototype is not linked to the %Pattern. Style changes of the 
+	 *  prototype apply to all pads after the next @c update() .
+	 */
+	T* getPadPrototype () const;
+
 	/**
      *  @brief  Optimizes the widget extends.
      *
@@ -419,6 +599,57 @@ protected:
 
 	void updatePads();
 
+	void createPads ();
+
+	void deletePads ();
+
+	/**
+	 *  @brief  Emits all not yet emitted changes and the resulting value as
+	 *  a single ValueChangeDeltaEvent.
+	 */
+	void emitChanges ();
+
+	/**
+	 *  @brief  Gets the area of a pad slot (pad plus gaps).
+	 *  @param column  %Pattern column (starting with 0). 
+	 *  @param row  %Pattern row (starting with 0).
+	 *  @return  Area relative to the %Pattern origin, aligned to full pixels
+	 *  and limited to the effective widget area.
+	 */
+	BUtilities::Area<> getPadArea (const size_t column, const size_t row) const;
+
+	/**
+	 *  @brief  Marks a pad as damaged and exposes its area. Flyweight mode
+	 *  only.
+	 *  @param column  %Pattern column (starting with 0). 
+	 *  @param row  %Pattern row (starting with 0).
+	 */
+	void damagePad (const size_t column, const size_t row);
+
+	/**
+	 *  @brief  Gets the rendered surface of a pad. Flyweight mode only.
+	 *  @param value  Pad value.
+	 *  @param width  Pad width.
+	 *  @param height  Pad height.
+	 *  @param cache  True to use (and fill) the cache of rendered pads.
+	 *  @return  Pointer to the surface. Only valid until the next call.
+	 */
+	cairo_surface_t* renderPad (const typename T::value_type& value, const double width, const double height, const bool cache);
+
+	void clearPadCache ();
+
+	/**
+	 *  @brief  Draws all pads intersecting an area. Flyweight mode only.
+	 *  @param cr  Cairo context.
+	 *  @param area  Area.
+	 */
+	void drawPads (cairo_t* cr, const BUtilities::Area<>& area);
+
+	/**
+	 *  @brief  Redraws the damaged pads only. Flyweight mode only.
+	 */
+	void drawDamage ();
+
 	/**
      *  @brief  Unclipped draw to the surface (if is visualizable).
      */
@@ -457,6 +688,7 @@ inline typename Pattern<T>::PadsTemplType& Pattern<T>::PadsTemplType::operator=
 	ValueTransferable<typename T::value_type>::operator= (that);
 	ValidatableRange<typename T::value_type>::operator= (that);
 	ValueableTyped<typename T::value_type>::operator= (that);
+	return *this;
 }
 
 template <class T>
@@ -516,15 +748,16 @@ inline Pattern<T>::Pattern	(const uint32_t urid, const std::string& title) :
 }
 
 template <class T>
-inline Pattern<T>::Pattern	(const size_t columns, const size_t rows, uint32_t urid, std::string title) :
-	Pattern	(0.0, 0.0, BWIDGETS_DEFAULT_PATTERN_WIDTH, BWIDGETS_DEFAULT_PATTERN_HEIGHT, columns, rows, urid, title) 
+inline Pattern<T>::Pattern	(const size_t columns, const size_t rows, uint32_t urid, std::string title, const bool flyweight) :
+	Pattern	(0.0, 0.0, BWIDGETS_DEFAULT_PATTERN_WIDTH, BWIDGETS_DEFAULT_PATTERN_HEIGHT, columns, rows, urid, title, flyweight) 
 {
 
 }
 
 template <class T>
 inline Pattern<T>::Pattern	(const double x, const double y, const double width, const double height, 
-						 	 const size_t columns, const size_t rows, uint32_t urid, std::string title) :
+						 	 const size_t columns, const size_t rows, uint32_t urid, std::string title,
+							 const bool flyweight) :
 	Widget (x, y, width, height, urid, title),
 	ValueableTyped<std::vector<std::vector<std::pair<BUtilities::Point<size_t>, typename T::value_type>>>> (),
 	Clickable (),
@@ -538,46 +771,49 @@ inline Pattern<T>::Pattern	(const double x, const double y, const double width,
 	editMode_ (MODE_EDIT),
 	allowYMerge_ (false),
 	clipBoard_(),
+	flyweight_ (flyweight),
+	cells_ (columns * rows, typename T::value_type ()),
+	damage_ (),
+	damaged_ (columns * rows, false),
+	fullDraw_ (true),
+	prototype_ (new PadRenderer (BUtilities::Urid::urid (BUtilities::Urid::uri (urid) + "/pad"), "")),
+	padCache_ (),
+	padIndex_ (),
+	changes_ (),
+	extentsChanged_ (false),
+	shared_ (),
+	batch_ (0),
+	journal_ (),
+	replaying_ (false),
+	stroke_ (false),
 	padOn_ (false)
 {
 	pads.setValue (1.0);
 	for (size_t r = 0; r < rows_; ++r)
 	{
 		std::vector<std::pair<BUtilities::Point<size_t>, typename T::value_type>> vs;
-		std::vector<Widget*> ws;
 
 		for (size_t c = 0; c < columns_; ++c)
 		{
-			T* w = new T(BUtilities::Urid::urid (BUtilities::Urid::uri (urid) + "/pad"), "(" + std::to_string(c) + ", " + std::to_string(r) + ")");
-			w->setCallbackFunction (BEvents::Event::VALUE_CHANGED_EVENT, padChangedCallback);
-			w->setClickable (false);
-			w->setEventPassable(BEvents::Event::BUTTON_EVENTS + BEvents::Event::POINTER_DRAG_EVENT);
-			add (w);
-			ws.push_back (w);
-
 			BUtilities::Point<size_t> ext (0, 0);
 			typename T::value_type value = typename T::value_type ();
 			std::pair<BUtilities::Point<size_t>, typename T::value_type> v (ext, value);
 			vs.push_back (v);
 		}
 
-		pads_.push_back (ws);
 		this->value_.push_back (vs);
 	}
+
+	if (!flyweight_) createPads();
 }
 
 template <class T>
 inline Pattern<T>::~Pattern ()
 {
 	if (getParentWidget()) getParentWidget()->release (this);
-
-	for (size_t r = 0; r < rows_; ++r)
-	{
-		for (size_t c = 0; c < columns_; ++c)
-		{
-			if (pads_[r][c]) delete pads_[r][c];
-		}
-	}
+	deletePads();
+	clearPadCache();
+	delete prototype_;
 }
 
 template <class T>
@@ -593,46 +829,221 @@ inline void Pattern<T>::copy (const Pattern<T>* that)
 {
 	pads = that->pads;
 
-	for (size_t r = 0; r < rows_; ++r)
-	{
-		for (size_t c = 0; c < columns_; ++c)
-		{
-			if (pads_[r][c]) delete pads_[r][c];
-			pads_[r][c] = nullptr;
-		}
-	}
-	pads_.clear();
+	deletePads();
 
 	columns_ = that->columns_;
 	rows_ = that->rows_;
-
-	for (size_t r = 0; r < rows_; ++r)
+	flyweight_ = that->flyweight_;
+	cells_ = that->cells_;
+	damage_.clear();
+	damaged_.assign (columns_ * rows_, false);
+	fullDraw_ = true;
+	prototype_->copy (that->prototype_);
+	clearPadCache();
+
+	for (size_t r = 0; r < that->pads_.size(); ++r)
 	{
 		std::vector<Widget*> ws;
 
-		for (size_t c = 0; c < columns_; ++c)
+		for (size_t c = 0; c < that->pads_[r].size(); ++c)
 		{
 			Widget* w = (that->pads_[r][c] ? that->pads_[r][c]->clone() : nullptr);
-			add (w);
+			if (w) 
+			{
+				add (w);
+				padIndex_[w] = r * columns_ + c;
+			}
 			ws.push_back (w);
 		}
 
 		pads_.push_back (ws);
 	}
 
-	selection_ = that->selectionPos_;
+	selection_ = that->selection_;
 	selected_ = that->selected_;
 	editMode_ = that->editMode_;
 	allowYMerge_ = that->allowYMerge_;
 	clipBoard_ = that->clipBoard_;
-	padOn_ = that->padOn;
+	journal_ = that->journal_;
+	padOn_ = that->padOn_;
 
 	Draggable::operator= (*that);
 	Clickable::operator= (*that);
 	ValueableTyped<value_type>::operator= (*that);
+	shared_.reset();
 	Widget::copy (that);
 }
 
+template <class T>
+inline void Pattern<T>::setValue (const value_type& value)
+{
+	if (value == this->value_) return;
+
+	// Take over the pads within the pattern and collect changes
+	beginChange();
+	for (size_t r = 0; (r < rows_) && (r < value.size()); ++r)
+	{
+		for (size_t c = 0; (c < columns_) && (c < value[r].size()); ++c)
+		{
+			if (this->value_[r][c].first != value[r][c].first)
+			{
+				this->value_[r][c].first = value[r][c].first;
+				extentsChanged_ = true;
+			}
+			setPadValue (c, r, value[r][c].second);
+		}
+	}
+	endChange();
+	update();
+}
+
+template <class T>
+inline void Pattern<T>::setValue (value_type&& value)
+{
+	setValue (static_cast<const value_type&> (value));
+}
+
+template <class T>
+inline void Pattern<T>::setFlyweight (const bool flyweight)
+{
+	if (flyweight == flyweight_) return;
+
+	if (flyweight)
+	{
+		// Take over the values from the pad widgets
+		beginChange();
+		for (size_t r = 0; r < rows_; ++r)
+		{
+			for (size_t c = 0; c < columns_; ++c)
+			{
+				T* w = dynamic_cast<T*>(pads_[r][c]);
+				if (w) setPadValue (c, r, w->getValue());
+				cells_[r * columns_ + c] = this->value_[r][c].second;
+			}
+		}
+		endChange();
+		deletePads();
+		flyweight_ = true;
+	}
+
+	else
+	{
+		flyweight_ = false;
+		createPads();
+		damage_.clear();
+		damaged_.assign (columns_ * rows_, false);
+		clearPadCache();
+	}
+
+	update();
+}
+
+template <class T>
+inline bool Pattern<T>::isFlyweight () const
+{
+	return flyweight_;
+}
+
+template <class T>
+inline void Pattern<T>::setPadValue (const size_t column, const size_t row, const typename T::value_type& value)
+{
+	if ((column >= columns_) || (row >= rows_)) return;
+
+	typename T::value_type nval = value;
+	if (flyweight_)
+	{
+		// Validate
+		Validatable<typename T::value_type>* validatable = dynamic_cast<Validatable<typename T::value_type>*>(prototype_);
+		if (validatable && validatable->isValidatable()) nval = validatable->validate (value);
+	}
+
+	else
+	{
+		T* w = dynamic_cast<T*>(pads_[row][column]);
+		if (!w) return;
+		w->setValue (value);
+		nval = w->getValue();
+	}
+
+	const typename T::value_type oval = this->value_[row][column].second;
+	if (oval == nval) return;
+	this->value_[row][column].second = nval;
+	if (!replaying_) journal_.add (row * columns_ + column, oval, nval);
+	if (flyweight_)
+	{
+		cells_[row * columns_ + column] = nval;
+		damagePad (column, row);
+	}
+
+	changes_.push_back (PadChange {column, row, nval});
+	if (batch_ == 0) emitChanges();
+}
+
+template <class T>
+inline typename T::value_type Pattern<T>::getPadValue (const size_t column, const size_t row) const
+{
+	if ((column >= columns_) || (row >= rows_)) return typename T::value_type ();
+	if (flyweight_) return cells_[row * columns_ + column];
+
+	T* w = dynamic_cast<T*>(pads_[row][column]);
+	return (w ? w->getValue() : this->value_[row][column].second);
+}
+
+template <class T>
+inline void Pattern<T>::beginChange ()
+{
+	++batch_;
+	journal_.begin();
+}
+
+template <class T>
+inline void Pattern<T>::endChange ()
+{
+	journal_.end();
+	if (batch_ > 0) --batch_;
+	if (batch_ == 0) emitChanges();
+}
+
+template <class T>
+inline bool Pattern<T>::undo ()
+{
+	if (!journal_.canUndo()) return false;
+
+	const typename BUtilities::Journal<size_t, typename T::value_type>::Action action = journal_.undo();
+	replaying_ = true;
+	beginChange();
+	for (typename BUtilities::Journal<size_t, typename T::value_type>::Action::const_reverse_iterator it = action.rbegin(); it != action.rend(); ++it)
+	{
+		setPadValue (it->key % columns_, it->key / columns_, it->from);
+	}
+	endChange();
+	replaying_ = false;
+	return true;
+}
+
+template <class T>
+inline bool Pattern<T>::redo ()
+{
+	if (!journal_.canRedo()) return false;
+
+	const typename BUtilities::Journal<size_t, typename T::value_type>::Action action = journal_.redo();
+	replaying_ = true;
+	beginChange();
+	for (const typename BUtilities::Journal<size_t, typename T::value_type>::Change& c : action)
+	{
+		setPadValue (c.key % columns_, c.key / columns_, c.to);
+	}
+	endChange();
+	replaying_ = false;
+	return true;
+}
+
+template <class T>
+inline BUtilities::Journal<size_t, typename T::value_type>& Pattern<T>::getJournal ()
+{
+	return journal_;
+}
+
 template <class T>
 void Pattern<T>::setEditMode (const EditMode editMode)
 {
@@ -690,8 +1101,10 @@ void Pattern<T>::action (const EditMode mode, const BUtilities::Area<size_t> sel
 template <class T>
 void Pattern<T>::cutValues(const BUtilities::Area<size_t> selection)
 {
+	beginChange();
 	copyValues (selection);
 	deleteValues (selection);
+	endChange();
 }
 
 template <class T>
@@ -716,78 +1129,92 @@ void Pattern<T>::copyValues(const BUtilities::Area<size_t> selection)
 template <class T>
 void Pattern<T>::pasteValues(const BUtilities::Point<size_t> pos)
 {
+	beginChange();
 	for (size_t dr = 0; (dr < clipBoard_.size()) && (pos.y + dr < rows_); ++dr)
 	{
 		const std::vector<std::pair<BUtilities::Point<size_t>, typename T::value_type>> vs = clipBoard_[dr];
 		for (size_t dc = 0; (dc < vs.size()) && (pos.x + dc < columns_); ++dc)
 		{
 			const std::pair<BUtilities::Point<size_t>, typename T::value_type> v = vs[dc];
-			T* w = dynamic_cast<T*>(pads_[pos.y + dr][pos.x + dc]);
-			w->setValue (v.second);
+			setPadValue (pos.x + dc, pos.y + dr, v.second);
 			// TODO pad extends
 		}
 	}
+	endChange();
 }
 
 template <class T>
 void Pattern<T>::deleteValues(const BUtilities::Area<size_t> selection)
 {
+	beginChange();
 	for (size_t dr = 0; dr <= selection.getHeight(); ++dr)
 	{
 		for (size_t dc = 0; dc <= selection.getWidth(); ++dc)
 		{
-			T* w = dynamic_cast<T*>(pads_[selection.getY() + dr][selection.getX() + dc]);
-			w->setValue (w->getMin());
+			setPadValue (selection.getX() + dc, selection.getY() + dr, prototype_->getMin());
 		}
 	}
+	endChange();
 }
 
 template <class T>
 void Pattern<T>::xflipValues(const BUtilities::Area<size_t> selection)
 {
+	beginChange();
 	for (size_t dr = 0; dr <= selection.getHeight(); ++dr)
 	{
 		for (size_t dc = 0; dc < (selection.getWidth() + 1) / 2; ++dc)
 		{
-			T* w1 = dynamic_cast<T*>(pads_[selection.getY() + dr][selection.getX() + dc]);
-			T* w2 = dynamic_cast<T*>(pads_[selection.getY() + dr][selection.getX() + selection.getWidth() - dc]);
-			typename T::value_type v2 = w2->getValue();
-			w2->setValue (w1->getValue());
-			w1->setValue (v2);
+			const size_t r = selection.getY() + dr;
+			const size_t c1 = selection.getX() + dc;
+			const size_t c2 = selection.getX() + selection.getWidth() - dc;
+			const typename T::value_type v2 = getPadValue (c2, r);
+			setPadValue (c2, r, getPadValue (c1, r));
+			setPadValue (c1, r, v2);
 		}
 	}
+	endChange();
 }
 
 template <class T>
 void Pattern<T>::yflipValues(const BUtilities::Area<size_t> selection)
 {
+	beginChange();
 	for (size_t dr = 0; dr < (selection.getHeight() + 1) / 2; ++dr)
 	{
 		for (size_t dc = 0; dc <= selection.getWidth() ; ++dc)
 		{
-			T* w1 = dynamic_cast<T*>(pads_[selection.getY() + dr][selection.getX() + dc]);
-			T* w2 = dynamic_cast<T*>(pads_[selection.getY() + selection.getHeight() - dr][selection.getX() + dc]);
-			typename T::value_type v2 = w2->getValue();
-			w2->setValue (w1->getValue());
-			w1->setValue (v2);
+			const size_t c = selection.getX() + dc;
+			const size_t r1 = selection.getY() + dr;
+			const size_t r2 = selection.getY() + selection.getHeight() - dr;
+			const typename T::value_type v2 = getPadValue (c, r2);
+			setPadValue (c, r2, getPadValue (c, r1));
+			setPadValue (c, r1, v2);
 		}
 	}
+	endChange();
 }
 
 template <class T>
 inline Widget* Pattern<T>::getPad (const size_t column, const size_t row) const
 {
-	return ((column < columns_) && (row < rows_) ? pads_[row][column] : nullptr);
+	return ((!flyweight_) && (column < columns_) && (row < rows_) ? pads_[row][column] : nullptr);
+}
+
+template <class T>
+inline T* Pattern<T>::getPadPrototype () const
+{
+	return prototype_;
 }
 
 template <class T>
 inline void Pattern<T>::resize ()
 {
 	double y = getYOffset();
-	for (size_t r = 0; r < rows_; ++r)
+	for (size_t r = 0; r < pads_.size(); ++r)
 	{
 		double x = getXOffset();
-		for (size_t c = 0; c < columns_; ++c)
+		for (size_t c = 0; c < pads_[r].size(); ++c)
 		{
 			pads_[r][c]->resize ();
 			pads_[r][c]->moveTo (x, y);
@@ -813,9 +1240,11 @@ inline void Pattern<T>::resize (const BUtilities::Point<> extends)
 template <class T>
 inline void Pattern<T>::update ()
 {
-	for (size_t r = 0; r < rows_; ++r)
+	fullDraw_ = true;
+
+	for (size_t r = 0; r < pads_.size(); ++r)
 	{
-		for (size_t c = 0; c < columns_; /*empty*/)
+		for (size_t c = 0; c < pads_[r].size(); /*empty*/)
 		{
 			size_t st = (allowYMerge_ ? this->getValue()[r][c].first.x + 1 : 1);
 
@@ -850,8 +1279,15 @@ inline void Pattern<T>::onButtonPressed (BEvents::Event* event)
 	// Calculate position
 	const BUtilities::Point<size_t> p = getPadIndex (pev->getPosition().x, pev->getPosition().y);
 
+	// Record all changes until button release as a single action
+	if (!stroke_)
+	{
+		journal_.begin();
+		stroke_ = true;
+	}
+
 	// Pick mode:
-	if (editMode_ == MODE_PICK || (pev->getButton() == BDevices::MouseDevice::RIGHT_BUTTON)) pads.setValue (dynamic_cast<T*>(pads_[p.y][p.x])->getValue());
+	if (editMode_ == MODE_PICK || (pev->getButton() == BDevices::MouseDevice::RIGHT_BUTTON)) pads.setValue (getPadValue (p.x, p.y));
 
 	// Paste mode:
 	else if (editMode_ == MODE_PASTE) pasteValues (p);
@@ -862,10 +1298,9 @@ inline void Pattern<T>::onButtonPressed (BEvents::Event* event)
 	// Default: Invert pad value
 	else
 	{
-		T* w = dynamic_cast<T*>(pads_[p.y][p.x]);
 		typename T::value_type v = pads.getValue();
-		padOn_ = (w->getValue() != v);
-		w->setValue (padOn_ ? v : w->getMin());
+		padOn_ = (getPadValue (p.x, p.y) != v);
+		setPadValue (p.x, p.y, padOn_ ? v : prototype_->getMin());
 	}
 
 	Clickable::onButtonPressed (event);
@@ -879,6 +1314,11 @@ inline void Pattern<T>::onButtonReleased (BEvents::Event* event)
 
 	if (selected_ && isSelectMode() && (pev->getButton() == BDevices::MouseDevice::LEFT_BUTTON)) action (getEditMode(), selection_);
 	selected_ = false;
+	if (stroke_)
+	{
+		stroke_ = false;
+		journal_.end();
+	}
 	update();
 	Clickable::onButtonReleased (event);
 }
@@ -901,18 +1341,17 @@ inline void Pattern<T>::onPointerDragged (BEvents::Event* event)
 	{
 		// Calculate previous position
 		const BUtilities::Point<size_t> p2 = getPadIndex (pev->getPosition().x - pev->getDelta().x, pev->getPosition().y - pev->getDelta().y);
-		T* w = dynamic_cast<T*>(pads_[p.y][p.x]);
 
 		if (p != p2)
 		{
 			// Pick mode:
-			if (editMode_ == MODE_PICK || (pev->getButton() == BDevices::MouseDevice::RIGHT_BUTTON)) pads.setValue (dynamic_cast<T*>(pads_[p.y][p.x])->getValue());
+			if (editMode_ == MODE_PICK || (pev->getButton() == BDevices::MouseDevice::RIGHT_BUTTON)) pads.setValue (getPadValue (p.x, p.y));
 
 			// Paste mode:
 			else if (editMode_ == MODE_PASTE) pasteValues (p);
 
 			// Default: Set or unset pad
-			else w->setValue (padOn_ ? pads.getValue() : w->getMin());
+			else setPadValue (p.x, p.y, padOn_ ? pads.getValue() : prototype_->getMin());
 		}
 	}
 	Draggable::onPointerDragged (event);
@@ -928,23 +1367,9 @@ inline void Pattern<T>::padChangedCallback (BEvents::Event* event)
 	Pattern<T>* p = dynamic_cast<Pattern<T>*>(w->getParentWidget());
 	if (!p) return;
 
-	// Get column/row
-	// TODO from coordinates
-
-	// Fallback: iterate
-	for (size_t r = 0; r < p->rows_; ++r)
-	{
-		for (size_t c = 0; c < p->columns_; ++c)
-		{
-			if (w == p->pads_[r][c])
-			{
-				value_type v = p->getValue();
-				v[r][c].second = w->getValue();
-				p->setValue (v);
-				break;
-			}
-		}
-	}
+	std::unordered_map<const Widget*, size_t>::const_iterator it = p->padIndex_.find (w);
+	if ((it == p->padIndex_.end()) || (p->columns_ == 0)) return;
+	p->setPadValue (it->second % p->columns_, it->second / p->columns_, w->getValue());
 }
 
 template <class T>
@@ -970,9 +1395,13 @@ inline BUtilities::Point<size_t> Pattern<T>::getPadIndex (const double x, const
 template <class T>
 inline void Pattern<T>::updatePads()
 {
-	for (size_t r = 0; r < rows_; ++r)
+	prototype_->setRange (pads.getMin(), pads.getMax(), pads.getStep());
+	prototype_->setTransferFunction(pads.getTransferFunction());
+	prototype_->setReTransferFunction(pads.getReTransferFunction());
+
+	for (size_t r = 0; r < pads_.size(); ++r)
 	{
-		for (size_t c = 0; c < columns_; ++c)
+		for (size_t c = 0; c < pads_[r].size(); ++c)
 		{
 			T* w = dynamic_cast<T*>(pads_[r][c]);
 			w->setRange (pads.getMin(), pads.getMax(), pads.getStep());
@@ -980,12 +1409,229 @@ inline void Pattern<T>::updatePads()
 			w->setReTransferFunction(pads.getReTransferFunction());
 		}
 	}
+
+	if (flyweight_)
+	{
+		// Re-validate
+		beginChange();
+		for (size_t r = 0; r < rows_; ++r)
+		{
+			for (size_t c = 0; c < columns_; ++c) setPadValue (c, r, cells_[r * columns_ + c]);
+		}
+		endChange();
+		update();
+	}
+}
+
+template <class T>
+inline void Pattern<T>::createPads ()
+{
+	for (size_t r = 0; r < rows_; ++r)
+	{
+		std::vector<Widget*> ws;
+
+		for (size_t c = 0; c < columns_; ++c)
+		{
+			T* w = new T(BUtilities::Urid::urid (BUtilities::Urid::uri (getUrid()) + "/pad"), "(" + std::to_string(c) + ", " + std::to_string(r) + ")");
+			w->setRange (prototype_->getMin(), prototype_->getMax(), prototype_->getStep());
+			w->setTransferFunction (prototype_->getTransferFunction());
+			w->setReTransferFunction (prototype_->getReTransferFunction());
+			w->setValue (cells_[r * columns_ + c]);
+			w->setCallbackFunction (BEvents::Event::VALUE_CHANGED_EVENT, padChangedCallback);
+			w->setClickable (false);
+			w->setEventPassable(BEvents::Event::BUTTON_EVENTS + BEvents::Event::POINTER_DRAG_EVENT);
+			add (w);
+			ws.push_back (w);
+			padIndex_[w] = r * columns_ + c;
+		}
+
+		pads_.push_back (ws);
+	}
+}
+
+template <class T>
+inline void Pattern<T>::deletePads ()
+{
+	for (size_t r = 0; r < pads_.size(); ++r)
+	{
+		for (size_t c = 0; c < pads_[r].size(); ++c)
+		{
+			if (pads_[r][c]) delete pads_[r][c];
+			pads_[r][c] = nullptr;
+		}
+	}
+	pads_.clear();
+	padIndex_.clear();
+}
+
+template <class T>
+inline void Pattern<T>::emitChanges ()
+{
+	if (changes_.empty() && (!extentsChanged_)) return;
+
+	Window* window = getMainWindow();
+	if (window)
+	{
+		// Copy on write: Only update the changed pads if no event holds the
+		// shared value anymore
+		if (shared_ && (shared_.use_count() == 1) && (!extentsChanged_))
+		{
+			for (const PadChange& c : changes_) (*shared_)[c.row][c.column].second = c.value;
+		}
+		else shared_ = std::make_shared<value_type> (this->value_);
+
+		BEvents::ValueChangeDeltaEvent<PadChange, value_type>* event = 
+			new BEvents::ValueChangeDeltaEvent<PadChange, value_type> (this, shared_, changes_);
+		window->addEventToQueue (event);
+	}
+	else shared_.reset();
+	changes_.clear();
+	extentsChanged_ = false;
+}
+
+template <class T>
+inline BUtilities::Area<> Pattern<T>::getPadArea (const size_t column, const size_t row) const
+{
+	const double x0 = getXOffset ();
+	const double y0 = getYOffset ();
+	const double w = getEffectiveWidth ();
+	const double h = getEffectiveHeight ();
+	if ((columns_ == 0) || (rows_ == 0)) return BUtilities::Area<> ();
+
+	const size_t st = (allowYMerge_ ? this->value_[row][column].first.x + 1 : 1);
+	const double x1 = floor (x0 + w * static_cast<double>(column) / static_cast<double>(columns_) - 1.0);
+	const double x2 = ceil (x0 + w * static_cast<double>(column + st) / static_cast<double>(columns_) + 1.0);
+	const double y1 = floor (y0 + h * static_cast<double>(row) / static_cast<double>(rows_) - 1.0);
+	const double y2 = ceil (y0 + h * static_cast<double>(row + 1) / static_cast<double>(rows_) + 1.0);
+	BUtilities::Area<> a = BUtilities::Area<> (x1, y1, x2 - x1, y2 - y1);
+	a.intersect (BUtilities::Area<> (x0, y0, w, h));
+	return a;
+}
+
+template <class T>
+inline void Pattern<T>::damagePad (const size_t column, const size_t row)
+{
+	if ((!flyweight_) || (column >= columns_) || (row >= rows_)) return;
+
+	const size_t i = row * columns_ + column;
+	if (!damaged_[i])
+	{
+		damaged_[i] = true;
+		damage_.push_back (i);
+	}
+	scheduleDraw_ = true;
+
+	if (isVisible ())
+	{
+		BUtilities::Area<> a = getPadArea (column, row);
+		a.moveTo (a.getPosition() + getAbsolutePosition());
+		emitExposeEvent (a);
+	}
+}
+
+template <class T>
+inline cairo_surface_t* Pattern<T>::renderPad (const typename T::value_type& value, const double width, const double height, const bool cache)
+{
+	if (cache)
+	{
+		typename std::map<typename T::value_type, cairo_surface_t*>::const_iterator it = padCache_.find (value);
+		if (it != padCache_.end()) return it->second;
+	}
+
+	prototype_->resize (width, height);
+	prototype_->setValue (value);
+	prototype_->render();
+	cairo_surface_t* surface = prototype_->cairoSurface();
+
+	if (cache && (padCache_.size() < BWIDGETS_DEFAULT_PATTERN_PAD_CACHE_SIZE))
+	{
+		surface = cairoplus_image_surface_clone_from_image_surface (surface);
+		padCache_[value] = surface;
+	}
+
+	return surface;
+}
+
+template <class T>
+inline void Pattern<T>::clearPadCache ()
+{
+	for (typename std::map<typename T::value_type, cairo_surface_t*>::iterator it = padCache_.begin(); it != padCache_.end(); ++it)
+	{
+		cairo_surface_destroy (it->second);
+	}
+	padCache_.clear();
+}
+
+template <class T>
+inline void Pattern<T>::drawPads (cairo_t* cr, const BUtilities::Area<>& area)
+{
+	const double x0 = getXOffset ();
+	const double y0 = getYOffset ();
+	const double w = getEffectiveWidth ();
+	const double h = getEffectiveHeight ();
+	if ((columns_ == 0) || (rows_ == 0) || (w < 1.0) || (h < 1.0)) return;
+
+	const double cw = w / static_cast<double>(columns_);
+	const double ch = h / static_cast<double>(rows_);
+
+	// Range of rows and columns within area
+	const size_t r1 = std::min (static_cast<size_t> (std::max (floor ((area.getY() - y0) / ch), 0.0)), rows_);
+	const size_t r2 = std::min (static_cast<size_t> (std::max (ceil ((area.getY() + area.getHeight() - y0) / ch), 0.0)), rows_);
+	const size_t c1 = std::min (static_cast<size_t> (std::max (floor ((area.getX() - x0) / cw), 0.0)), columns_);
+	const size_t c2 = std::min (static_cast<size_t> (std::max (ceil ((area.getX() + area.getWidth() - x0) / cw), 0.0)), columns_);
+
+	for (size_t r = r1; r < r2; ++r)
+	{
+		for (size_t c = (allowYMerge_ ? 0 : c1); c < c2; /* empty */)
+		{
+			const size_t st = (allowYMerge_ ? this->value_[r][c].first.x + 1 : 1);
+			const double xs = x0 + w * static_cast<double>(c) / static_cast<double>(columns_) + 0.01 * cw;
+			const double ys = y0 + h * static_cast<double>(r) / static_cast<double>(rows_) + 0.01 * ch;
+			const double ws = (static_cast<double> (st - 1) + 0.98) * cw;
+			const double hs = 0.98 * ch;
+
+			if (c + st > c1)
+			{
+				cairo_surface_t* surface = renderPad (cells_[r * columns_ + c], ws, hs, st == 1);
+				cairo_set_source_surface (cr, surface, xs, ys);
+				cairo_rectangle (cr, xs, ys, ws, hs);
+				cairo_fill (cr);
+			}
+
+			c += st;
+		}
+	}
+}
+
+template <class T>
+inline void Pattern<T>::drawDamage ()
+{
+	scheduleDraw_ = false;
+	if ((!surface_) || (cairo_surface_status (surface_) != CAIRO_STATUS_SUCCESS)) return;
+
+	cairo_t* cr = cairo_create (surface_);
+	if (cairo_status (cr) == CAIRO_STATUS_SUCCESS)
+	{
+		for (size_t i : damage_)
+		{
+			const BUtilities::Area<> a = getPadArea (i % columns_, i / columns_);
+			cairo_save (cr);
+			restoreBackground (cr, a);
+			drawPads (cr, a);
+			cairo_restore (cr);
+		}
+	}
+	cairo_destroy (cr);
+
+	for (size_t i : damage_) damaged_[i] = false;
+	damage_.clear();
 }
 
 template <class T>
 inline void Pattern<T>::draw ()
 {
-	draw (0, 0, getWidth(), getHeight());
+	if (flyweight_ && (!fullDraw_) && (!damage_.empty()) && (!(selected_ && isSelectMode()))) drawDamage ();
+	else draw (0, 0, getWidth(), getHeight());
 }
 
 template <class T>
@@ -1004,6 +1650,11 @@ inline void Pattern<T>::draw (const BUtilities::Area<>& area)
 			// Draw super class widget elements first
 			Widget::draw (area);
 
+			fullDraw_ = false;
+			for (size_t i : damage_) damaged_[i] = false;
+			damage_.clear();
+			clearPadCache();
+
 			cairo_t* cr = cairo_create (surface_);
 			if (cairo_status (cr) == CAIRO_STATUS_SUCCESS)
 			{
@@ -1042,6 +1693,8 @@ inline void Pattern<T>::draw (const BUtilities::Area<>& area)
 					
 				}
 
+				if (flyweight_) drawPads (cr, area);
+
 				cairo_destroy (cr);
 			}
 		}
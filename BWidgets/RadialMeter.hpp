@@ -28,9 +28,11 @@
 #include "Supports/ValueableTyped.hpp"
 #include "Supports/ValidatableRange.hpp"
 #include "Supports/ValueTransferable.hpp"
+#include "Supports/MeterFeedable.hpp"
 #include BWIDGETS_DEFAULT_DRAWRMETER_PATH
 #include <cairo/cairo.h>
 #include <cmath>
+#include <algorithm>
 
 #ifndef BWIDGETS_DEFAULT_RADIALMETER_WIDTH
 #define BWIDGETS_DEFAULT_RADIALMETER_WIDTH 40.0
@@ -59,15 +61,24 @@ namespace BWidgets
  *  Advanced settings allow a %RadialMeter to display a value in a non-linear
  *  manner (e.g. for levels and frequencies) using transfer functions and / or
  *  to use non-line color gradients for display using gradient functions.
+ *
+ *  Audio data can also be fed from the DSP thread via MeterFeedable. The
+ *  resulting level is set as value once per main window cycle.
  */
 class RadialMeter :	public Widget, 
 				public ValueableTyped<double>, 
 				public ValidatableRange<double>, 
-				public ValueTransferable<double>
+				public ValueTransferable<double>,
+				public MeterFeedable
 {
 protected:
 	BUtilities::Area<> scale_;
 	std::function<double (const double& x)> gradient_ = noTransfer;
+	cairo_surface_t* staticSurface_;
+	BUtilities::Area<> staticScale_;
+	double staticStep_;
+	BStyles::Color staticBgColor_;
+	double hold_;
 
 public:
 
@@ -118,6 +129,8 @@ public:
 			 std::function<double (const double& x)> reTransferFunc = ValueTransferable<double>::noTransfer,
 			 uint32_t urid = URID_UNKNOWN_URID, std::string title = "");
 
+	virtual ~RadialMeter();
+
 	/**
 	 *  @brief  Creates a clone of the %RadialMeter. 
 	 *  @return  Pointer to the new %RadialMeter.
@@ -199,6 +212,28 @@ public:
 
 protected:
 	/**
+	 *  @brief  Publishes a level processed from the meter feed.
+	 *  @param level  Level.
+	 *  @param hold  Peak hold level.
+	 *
+	 *  Sets the value to @a level and shows a peak hold marker at @a hold .
+	 */
+	virtual void publishLevel (const double level, const double hold) override;
+
+	/**
+	 *  @brief  Renders the static elements of the %RadialMeter to the static
+	 *  surface.
+	 *  @param step  Relative size of each segment.
+	 *  @param bgColor  Bar RGBA color.
+	 *
+	 *  The static surface keeps the value-independent elements (background,
+	 *  border, and inactive segments) and is blitted on each draw. It is
+	 *  only re-rendered if the widget extends, the scale, @a step, or
+	 *  @a bgColor changed since the last call.
+	 */
+	virtual void drawStatic (const double step, const BStyles::Color& bgColor);
+
+	/**
      *  @brief  Unclipped draw a %RadialMeter to the surface.
      */
     virtual void draw () override;
@@ -255,10 +290,20 @@ inline RadialMeter::RadialMeter	(const double  x, const double y, const double w
 	ValueableTyped<double> (value),
 	ValidatableRange<double> (min, max, step),
 	ValueTransferable<double> (transferFunc, reTransferFunc),
-	scale_ (0, 0, width, height)
+	scale_ (0, 0, width, height),
+	staticSurface_ (nullptr),
+	staticScale_ (),
+	staticStep_ (0.0),
+	staticBgColor_ (),
+	hold_ (0.0)
 {
 }
 
+inline RadialMeter::~RadialMeter()
+{
+	if (staticSurface_) cairo_surface_destroy (staticSurface_);
+}
+
 inline Widget* RadialMeter::clone () const 
 {
 	Widget* f = new RadialMeter (urid_, title_);
@@ -270,7 +315,10 @@ inline void RadialMeter::copy (const RadialMeter* that)
 {
 	scale_ = that->scale_;
 	gradient_ = that->gradient_;
+	if (staticSurface_) cairo_surface_destroy (staticSurface_);
+	staticSurface_ = nullptr;
 	ValueTransferable<double>::operator= (*that);
+	MeterFeedable::operator= (*that);
 	ValidatableRange<double>::operator= (*that);
 	ValueableTyped<double>::operator= (*that);
 	Widget::copy (that);
@@ -323,6 +371,45 @@ inline void RadialMeter::setHiColors (const BStyles::ColorMap& colors)
     style_[BUtilities::Urid::urid (STYLEPROPERTY_HICOLORS_URI)] = BUtilities::makeAny<BStyles::ColorMap> (colors);
 }
 
+inline void RadialMeter::publishLevel (const double level, const double hold)
+{
+	const double value = getValue();
+	const bool holdChanged = (hold != hold_);
+	hold_ = hold;
+	setValue (level);
+
+	// Value unchanged: Update the marker only
+	if (holdChanged && (getValue() == value)) update ();
+}
+
+inline void RadialMeter::drawStatic (const double step, const BStyles::Color& bgColor)
+{
+	if
+	(
+		staticSurface_ &&
+		(cairo_image_surface_get_width (staticSurface_) == cairo_image_surface_get_width (surface_)) &&
+		(cairo_image_surface_get_height (staticSurface_) == cairo_image_surface_get_height (surface_)) &&
+		(staticScale_ == scale_) &&
+		(staticStep_ == step) &&
+		(staticBgColor_ == bgColor)
+	) return;
+
+	if (staticSurface_) cairo_surface_destroy (staticSurface_);
+	staticSurface_ = cairo_image_surface_create (CAIRO_FORMAT_ARGB32, getWidth(), getHeight());
+	staticScale_ = scale_;
+	staticStep_ = step;
+	staticBgColor_ = bgColor;
+
+	if (cairo_surface_status (staticSurface_) != CAIRO_STATUS_SUCCESS) return;
+	cairo_t* cr = cairo_create (staticSurface_);
+	if (cairo_status (cr) == CAIRO_STATUS_SUCCESS)
+	{
+		const double rad = 0.5 * (scale_.getWidth() < scale_.getHeight() ? scale_.getWidth() : scale_.getHeight());
+		drawRMeterStatic (cr, 0.5 * scale_.getWidth(), 0.5 * scale_.getHeight(), rad, step, bgColor);
+	}
+	cairo_destroy (cr);
+}
+
 inline void RadialMeter::draw ()
 {
 	draw (0, 0, getWidth(), getHeight());
@@ -355,16 +442,36 @@ inline void RadialMeter::draw (const BUtilities::Area<>& area)
 			const double rval = getRatioFromValue (getValue());
 			const double drv = (std::fabs (getStep()) > 1.0 / (1.5 * M_PI * rad) ? fabs (getStep() / (getMax() - getMin())) : 1.0 / (1.5 * M_PI * rad));
 
+			// Blit static elements
+			drawStatic (drv, getBgColors()[getStatus()]);
+			if (staticSurface_ && (cairo_surface_status (staticSurface_) == CAIRO_STATUS_SUCCESS))
+			{
+				cairo_set_source_surface (cr, staticSurface_, 0, 0);
+				cairo_paint (cr);
+			}
+
+			// Draw active segments
 			if (step_ >= 0.0)
 			{
-				drawRMeter	(cr, 0.5 * scale_.getWidth(), 0.5 * scale_.getHeight(), rad, 0.0, rval, drv, 
-								 getFgColors()[getStatus()], getHiColors()[getStatus()], gradient_, getBgColors()[getStatus()]);
+				drawRMeterActive	(cr, 0.5 * scale_.getWidth(), 0.5 * scale_.getHeight(), rad, 0.0, rval, drv, 
+								 getFgColors()[getStatus()], getHiColors()[getStatus()], gradient_);
 			}
 
 			else 
 			{
-				drawRMeter	(cr, 0.5 * scale_.getWidth(), 0.5 * scale_.getHeight(), rad, 1.0 - rval, 1.0, drv, 
-								 getFgColors()[getStatus()], getHiColors()[getStatus()], gradient_, getBgColors()[getStatus()]);
+				drawRMeterActive	(cr, 0.5 * scale_.getWidth(), 0.5 * scale_.getHeight(), rad, 1.0 - rval, 1.0, drv, 
+								 getFgColors()[getStatus()], getHiColors()[getStatus()], gradient_);
+			}
+
+			// Draw peak hold marker
+			const double hval = std::max (std::min (getRatioFromValue (hold_), 1.0), 0.0);
+			if (hval > rval)
+			{
+				const double hpos = (step_ >= 0.0 ? hval : 1.0 - hval);
+				const double hmin = (step_ >= 0.0 ? hpos - drv : hpos);
+				const double hmax = (step_ >= 0.0 ? hpos : hpos + drv);
+				drawRMeterActive	(cr, 0.5 * scale_.getWidth(), 0.5 * scale_.getHeight(), rad, hmin, hmax, drv, 
+								 getFgColors()[getStatus()], getHiColors()[getStatus()], gradient_);
 			}
 		}
 
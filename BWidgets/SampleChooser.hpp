@@ -25,6 +25,7 @@
 #include "Frame.hpp"
 #include "Image.hpp"
 #include "../BMusic/Sample.hpp"
+#include "../BMusic/SampleLoader.hpp"
 #include <cairo/cairo.h>
 #include <sndfile.h>
 #include <utility>
@@ -58,6 +59,9 @@ namespace BWidgets
  *  The %SampleChooser is a widget based on FileChooser for the selection of 
  *  audio files and samples. It additionally shows the waveform of the
  *  selected audio file and allows to select a range as a Sample.
+ *
+ *  Audio files are loaded in the background. The waveform is shown 
+ *  progressively while loading. Selecting another file cancels loading.
  */
 class SampleChooser : public BWidgets::FileChooser
 {
@@ -120,6 +124,7 @@ public:
 																  		 BWIDGETS_DEFAULT_SAMPLECHOOSER_SOUNDFILES_REGEX}},
 					 uint32_t urid = URID_UNKNOWN_URID, std::string title = "");
 
+	virtual ~SampleChooser ();
 
 	/**
 	 *  @brief  Creates a clone of the %SampleChooser. 
@@ -210,9 +215,17 @@ public:
      */
 	virtual void update () override;
 
+	/**
+	 *  @brief  Method called by the main window once per frame. Shows the
+	 *  loading progress and takes over the loaded sample.
+	 */
+	virtual void poll () override;
+
 protected:
 
 	BMusic::Sample* sample_;
+	BMusic::SampleLoader loader_;
+	double loadProgress_;
 
 
 	static void sfileListBoxClickedCallback (BEvents::Event* event);
@@ -271,7 +284,9 @@ inline SampleChooser::SampleChooser	(const double x, const double y, const doubl
 	loopCheckbox (true, false, BUtilities::Urid::urid (BUtilities::Urid::uri (urid) + "/button"), ""),
 	loopLabel (BUtilities::Dictionary::get ("Play selection as loop"), BUtilities::Urid::urid (BUtilities::Urid::uri (urid) + "/label"), ""),
 	noFileLabel (BUtilities::Dictionary::get ("No audio file selected"), BUtilities::Urid::urid (BUtilities::Urid::uri (urid) + "/label"), ""),
-	sample_ (nullptr)
+	sample_ (nullptr),
+	loader_ (),
+	loadProgress_ (0.0)
 {
 	//std::vector<std::string> sampleLabels = {"Play selection as loop", "File", "Selection start", "Selection end", "frames", "No audio file selected"};
 	//labels.insert (labels.end(), sampleLabels.begin(), sampleLabels.end());
@@ -300,6 +315,11 @@ inline SampleChooser::SampleChooser	(const double x, const double y, const doubl
 	add (&noFileLabel);
 }
 
+inline SampleChooser::~SampleChooser ()
+{
+	if (sample_) delete sample_;
+}
+
 inline Widget* SampleChooser::clone () const 
 {
 	Widget* f = new SampleChooser (urid_, title_);
@@ -322,8 +342,9 @@ inline void SampleChooser::copy (const SampleChooser* that)
 	loopLabel.copy (&that->loopLabel);
 	noFileLabel.copy (&that->noFileLabel);
 
+	loader_.cancel();
 	if (sample_) delete sample_;
-	sample_ = new BMusic::Sample (*(that->sample_));
+	sample_ = (that->sample_ ? new BMusic::Sample (*(that->sample_)) : nullptr);
 
 	FileChooser::copy (that);
 }
@@ -341,19 +362,20 @@ inline void SampleChooser::setFileName (const std::string& filename)
 			delete (sample_);
 			sample_ = nullptr;
 		}
-		try {sample_ = new BMusic::Sample (rp);}
-		catch (std::exception& exc)
+
+		// Load in background, see poll()
+		if (rp)
 		{
-			std::cerr << exc.what() << "\n";
-			noFileLabel.setText (BUtilities::Dictionary::get ("No preview"));
+			loader_.load (rp);
+			loadProgress_ = 0.0;
+			noFileLabel.setText (BUtilities::Dictionary::get ("Loading") + " ...");
+			scrollbar.setValue (HRangeScrollBar::value_type (0.0, 1.0));
 		}
 
-		if (sample_)
+		else
 		{
-			sample_->start = 0;
-			sample_->end = sample_->info.frames;
-
-			scrollbar.setValue (HRangeScrollBar::value_type (0.0, 1.0));
+			loader_.cancel();
+			noFileLabel.setText (BUtilities::Dictionary::get ("No preview"));
 		}
 
 		update();
@@ -631,6 +653,47 @@ inline void SampleChooser::update ()
 	Widget::update();
 }
 
+inline void SampleChooser::poll ()
+{
+	FileChooser::poll();
+
+	switch (loader_.getStatus())
+	{
+		case BMusic::SampleLoader::LOADING:
+		{
+			const double progress = loader_.getProgress();
+			if (progress != loadProgress_)
+			{
+				loadProgress_ = progress;
+				noFileLabel.setText (BUtilities::Dictionary::get ("Loading") + " " + std::to_string (int (100.0 * progress)) + " %");
+				update();
+			}
+		}
+		break;
+
+		case BMusic::SampleLoader::READY:
+			if (sample_) delete sample_;
+			sample_ = loader_.release();
+			if (sample_)
+			{
+				sample_->start = 0;
+				sample_->end = sample_->info.frames;
+			}
+			update();
+			break;
+
+		case BMusic::SampleLoader::FAILED:
+			std::cerr << loader_.getError() << "\n";
+			loader_.cancel();
+			noFileLabel.setText (BUtilities::Dictionary::get ("No preview"));
+			update();
+			break;
+
+		default:
+			break;
+	}
+}
+
 inline void SampleChooser::sfileListBoxClickedCallback (BEvents::Event* event)
 {
 	if (!event) return;
@@ -647,6 +710,7 @@ inline void SampleChooser::sfileListBoxClickedCallback (BEvents::Event* event)
 		if (val <= fc->dirs_.size())
 		{
 			fc->fileNameBox.setText ("");
+			fc->loader_.cancel();
 			if (fc->sample_)
 			{
 				delete (fc->sample_);
@@ -658,11 +722,7 @@ inline void SampleChooser::sfileListBoxClickedCallback (BEvents::Event* event)
 		}
 
 		// File selected
-		else
-		{
-			Label* l = dynamic_cast<Label*>(w->getItem (val));
-			if (l) fc->setFileName (l->getText());
-		}
+		else fc->setFileName (w->getItem (val));
 
 		fc->update();
 	}
@@ -727,41 +787,51 @@ inline void SampleChooser::drawWaveform()
 	{
 		if (sample_ && (sample_->info.frames) && (sample_->info.samplerate) && (w >= 1.0))
 		{
-			// Scan for min/max
+			// Get min/max
 			const double start = scrollbar.getValue().first;
 			const double range = scrollbar.getValue().second - start;
-			double max = 1.0;
-			for (double i = 0.0; i < 1.0; i += 0.25 / w)
+			const double max = std::max (double (sample_->peaks->getMaxAbs (0)), 1.0);
+
+			// Get peaks for each pixel column
+			const int nrColumns = std::ceil (w);
+			const double frames = double (sample_->info.frames);
+			std::vector<double> los (nrColumns);
+			std::vector<double> his (nrColumns);
+			for (int x = 0; x < nrColumns; ++x)
 			{
-				if (fabs (sample_->get (i * double (sample_->info.frames), 0, sample_->info.samplerate)) > max)
+				const sf_count_t f0 = (start + double (x) / w * range) * frames;
+				const sf_count_t f1 = std::max (sf_count_t ((start + double (x + 1) / w * range) * frames), f0 + 1);
+				const BMusic::PeakPyramid::Peak peak = sample_->getPeak (f0, f1, 0);
+				double lo = peak.min;
+				double hi = peak.max;
+
+				// Connect to the previous column and force min. 1 px
+				if (x > 0)
 				{
-					max = fabs (sample_->get (i * double (sample_->info.frames), 0, sample_->info.samplerate));
+					lo = std::min (lo, his[x - 1]);
+					hi = std::max (hi, los[x - 1]);
 				}
+				if (hi - lo < 2.0 * max / h) hi = lo + 2.0 * max / h;
+
+				los[x] = lo;
+				his[x] = hi;
 			}
 
-			cairo_set_line_width (cr, 0.1);
-			double lo = sample_->get (start * double (sample_->info.frames), 0, sample_->info.samplerate);
-			double hi = lo;
-			const double step = 0.1 / w;
-			const double minstep = std::min (std::max (1.0 / (range * double (sample_->info.frames)), 0.01 * step), step);
-			for (double x = 0; x < 1.0; x += step)
+			// Draw columns in and out of the selection as batched paths
+			cairo_set_line_width (cr, 1.0);
+			for (int selected = 0; selected <= 1; ++selected)
 			{
-				double s = 0;
-				for (double xm = 0; xm < step; xm += minstep)
+				for (int x = 0; x < nrColumns; ++x)
 				{
-					const double f = (start + (x + xm) * range) * double (sample_->info.frames);
-					s = sample_->get (f, 0, sample_->info.samplerate);
-					if (s > hi) hi = s;
-					if (s < lo) lo = s;
+					const double frame = (start + double (x) / w * range) * frames;
+					const bool inSelection = ((frame >= sample_->start) && (frame <= sample_->end));
+					if (inSelection != bool (selected)) continue;
+					cairo_move_to (cr, x + 0.5, 0.5 * h - 0.5 * h * los[x] / max);
+					cairo_line_to (cr, x + 0.5, 0.5 * h - 0.5 * h * his[x] / max);
 				}
-				const double frame = (start + x * range) * double (sample_->info.frames);
-				if ((frame >= sample_->start) && (frame <= sample_->end)) cairo_set_source_rgba (cr, 1.0, 1.0, 1.0, 1.0);
+				if (selected) cairo_set_source_rgba (cr, 1.0, 1.0, 1.0, 1.0);
 				else cairo_set_source_rgba (cr, 0.25, 0.25, 0.25, 1.0);
-				cairo_move_to (cr, x * w, 0.5 * h - 0.5 * h * lo / max);
-				cairo_line_to (cr, x * w, 0.5 * h - 0.5 * h * hi / max);
 				cairo_stroke (cr);
-				lo = s;
-				hi = s + 2.0 * max / h;
 			}
 
 			// Set start and end line
@@ -823,7 +893,29 @@ inline void SampleChooser::drawWaveform()
 
 		else
 		{
+			// Preview of the sample under construction
+			SF_INFO info;
+			sf_count_t loaded = 0;
+			if (loader_.getPreviewInfo (info, loaded) && (info.frames > 0) && (w >= 1.0))
+			{
+				const double start = scrollbar.getValue().first;
+				const double range = scrollbar.getValue().second - start;
+				const double max = std::max (double (loader_.getPreviewMaxAbs (0)), 1.0);
+				const double frames = double (info.frames);
 
+				for (int x = 0; x < std::ceil (w); ++x)
+				{
+					const sf_count_t f0 = (start + double (x) / w * range) * frames;
+					if (f0 >= loaded) break;
+					const sf_count_t f1 = std::max (sf_count_t ((start + double (x + 1) / w * range) * frames), f0 + 1);
+					const BMusic::PeakPyramid::Peak peak = loader_.getPreviewPeak (f0, f1, 0);
+					cairo_move_to (cr, x + 0.5, 0.5 * h - 0.5 * h * peak.min / max);
+					cairo_line_to (cr, x + 0.5, 0.5 * h - 0.5 * h * std::max (double (peak.max), peak.min + 2.0 * max / h) / max);
+				}
+				cairo_set_line_width (cr, 1.0);
+				cairo_set_source_rgba (cr, 0.25, 0.25, 0.25, 1.0);
+				cairo_stroke (cr);
+			}
 		}
 		cairo_destroy (cr);
 	}
@@ -20,6 +20,7 @@
 
 #include "SpinButton.hpp"
 #include "Label.hpp"
+#include "ItemSource.hpp"
 #include "Supports/Clickable.hpp"
 #include "Supports/ValueableTyped.hpp"
 #include "Supports/Scrollable.hpp"
@@ -28,6 +29,7 @@
 #include <cstddef>
 #include <initializer_list>
 #include <limits>
+#include <vector>
 
 #ifndef BWIDGETS_DEFAULT_SPINBOX_WIDTH
 #define BWIDGETS_DEFAULT_SPINBOX_WIDTH 80.0
@@ -58,6 +60,11 @@ namespace BWidgets
  *  The value of the %SpinBox is the index of the active item starting with 1. 
  *  A value of 0 is used if no item is selected (default empty item).
  *
+ *  The items are provided by an ItemSource. By default, this is an internal
+ *  ItemList filled by @c addItem() and emptied by @c deleteItem() . The
+ *  items are not represented by widgets. Only the visible items are shown
+ *  by a pool of recycled Label rows.
+ *
  *  The visualble content of the %SpinBox is represented by its background and
  *  its border and by styles of the embedded widgets.
  *
@@ -68,7 +75,9 @@ class SpinBox : public Widget, public ValueableTyped<size_t>, public Clickable,
 {
 protected:
 	Widget* button_;
-	std::list<Widget*> items_;
+	ItemList items_;
+	const ItemSource* source_;
+	std::vector<Label*> rows_;
 	size_t top_;
 	double itemHeight_;
 	double buttonWidth_;
@@ -141,12 +150,42 @@ public:
      */
     virtual void setValue (const size_t& value) override;
 
+	/**
+     *  @brief  Changes the value.
+     *  @param value  Value.
+     *
+     *  Equivalent to @c setValue(const size_t&) .
+     */
+    virtual void setValue (size_t&& value) override;
+
 	/**
      *  @brief  Changes the value if the item text is part of the items.
      *  @param item  Item text.
      */
     virtual void setValue (const std::string& value);
 
+	/**
+	 *  @brief  Sets an external source of items.
+	 *  @param source  Pointer to the ItemSource or nullptr to use the
+	 *  internal ItemList. The ItemSource must persist as long as it is used
+	 *  by the widget.
+	 *
+	 *  Changes of an external ItemSource require a call of @c update() .
+	 */
+	void setItemSource (const ItemSource* source);
+
+	/**
+	 *  @brief  Gets the source of items.
+	 *  @return  Pointer to the ItemSource.
+	 */
+	const ItemSource* getItemSource () const;
+
+	/**
+	 *  @brief  Gets the number of items (without the Null item).
+	 *  @return  Number of items.
+	 */
+	size_t getItemCount () const;
+
 	/**
 	 *  @brief  Adds an item to the %SpinBox. 
 	 *  @param item  Item text string.
@@ -154,7 +193,7 @@ public:
 	 *  before (pos >= 1).
 	 *  
 	 *  Also increases the widget value if the insertion takes place in front 
-	 *  of the currently selected item.
+	 *  of the currently selected item. Only applies to the internal ItemList.
 	 */
 	void addItem (const std::string item, size_t pos = std::numeric_limits<size_t>::max());
 
@@ -165,7 +204,7 @@ public:
 	 *  before (pos >= 1).
 	 *
 	 *  Also increases the widget value if the insertion takes place in front 
-	 *  of the currently selected item.
+	 *  of the currently selected item. Only applies to the internal ItemList.
 	 */
 	void addItem (const std::initializer_list<const std::string> items, size_t pos = std::numeric_limits<size_t>::max());
 
@@ -174,30 +213,30 @@ public:
 	 *  @param pos  Index of the item to delete (pos >= 1).
 	 *
 	 *  Also decreases the widget value if the deletion takes place in front 
-	 *  of the currently selected item.
+	 *  of the currently selected item. Only applies to the internal ItemList.
 	 */
 	void deleteItem (const size_t pos);
 
 	/**
 	 *  @brief  Deletes all items (except the Null item).
 	 *
-	 *  Also sets the widget value to 0.
+	 *  Also sets the widget value to 0. Only applies to the internal ItemList.
 	 */
 	void deleteItem ();
 
 	/**
 	 *  @brief   Access to an item of the %SpinBox
 	 *  @param pos  Index of the item.
-	 *  @return  Pointer to the widget.
+	 *  @return  Item text string.
 	 */
-	Widget* getItem (const size_t pos) const;
+	std::string getItem (const size_t pos) const;
 
 	/**
-	 *  @brief   Access to an item of the %SpinBox
+	 *  @brief   Finds an item of the %SpinBox
 	 *  @param item  Item text string.
-	 *  @return  Pointer to the widget.
+	 *  @return  Index of the item, or 0 if not found.
 	 */
-	Widget* getItem (const std::string& item) const;
+	size_t findItem (const std::string& item) const;
 
 	/**
 	 *  @brief  Sets the width of the button.
@@ -215,8 +254,7 @@ public:
 	 *  @brief  Sets the height of each item to be added.
 	 *  @param height  Item height.
 	 *
-	 *  The change of the item height only takes effect for items added after
-	 *  the call of @c setItemHeight() of after call @c resizeItems() . 
+	 *  All items have got the same height.
 	 */
 	void setItemHeight (const double height);
 
@@ -227,7 +265,7 @@ public:
 	double getItemHeight () const;
 
 	/**
-	 *  @brief  Resizes all items to the same size.
+	 *  @brief  Resizes all item rows to the same size.
 	 * 
 	 *  The size is defined by the widgets effective width, the button width,
 	 *  and the item height.
@@ -251,6 +289,19 @@ public:
 
 protected:
 
+	/**
+	 *  @brief  Sets the number of Label rows in the pool.
+	 *  @param count  Number of rows.
+	 */
+	void allocateRows (const size_t count);
+
+	/**
+	 *  @brief  Fills a Label row with an item.
+	 *  @param row  Label row.
+	 *  @param pos  Index of the item.
+	 */
+	void fillRow (Label* row, const size_t pos) const;
+
 	/**
 	 *  @brief  Callback function which handles and forwards 
 	 *  VALUE_CHANGED_EVENTs from the SpinButton.
@@ -274,15 +325,14 @@ inline SpinBox::SpinBox	(const double x, const double y, const double width, con
 	Clickable(),
 	Scrollable(),
 	button_ (new SpinButton (x + width - height, y, height, height, 0, BUtilities::Urid::urid (BUtilities::Urid::uri (urid) + "/button"))),
-	items_ ({new Label (0, 0, getWidth() - getHeight(), getHeight(), "")}),	// Init with Null item
+	items_ (items),
+	source_ (&items_),
+	rows_ (),
 	top_ (0),
 	itemHeight_ (std::max (height - 2.0, 0.0)),
 	buttonWidth_ (BWIDGETS_DEFAULT_SPINBOX_BUTTON_WIDTH)
 {
-	items_.front()->setEventPassable(BEvents::Event::WHEEL_SCROLL_EVENT + BEvents::Event::BUTTON_PRESS_EVENT);
-	add (items_.front());
-	addItem (items);
-	if (getValue() >= items_.size()) setValue (0);
+	if (getValue() > getItemCount()) setValue (0);
 	else setValue (value_);
 	top_ = value_;
 	button_->setCallbackFunction(BEvents::Event::VALUE_CHANGED_EVENT, valueChangedCallback);
@@ -293,17 +343,7 @@ inline SpinBox::SpinBox	(const double x, const double y, const double width, con
 
 inline SpinBox::~SpinBox()
 {
-	deleteItem();
-
-	// Also delete Null item
-	while (!items_.empty())
-	{
-		std::list<Widget*>::iterator it = items_.begin();
-		Widget* w = *it;
-		items_.erase (it);
-		delete w;
-	}
-
+	allocateRows (0);
 	if (button_) delete button_;	
 }
 
@@ -320,14 +360,8 @@ inline void SpinBox::copy (const SpinBox* that)
 	button_ = that->button_->clone();
 	add (button_);
 
-	deleteItem();
-	for (Widget* w : that->items_)
-	{
-		Widget* w2 = w->clone();
-		items_.push_back (w2);
-		add (w2);
-	}
-
+	items_ = that->items_;
+	source_ = (that->source_ == &that->items_ ? &items_ : that->source_);
 	top_ = that->top_;
 	itemHeight_ = that->itemHeight_;
 	buttonWidth_ = that->buttonWidth_;
@@ -340,38 +374,58 @@ inline void SpinBox::copy (const SpinBox* that)
 
 inline void SpinBox::setValue (const size_t& value)
 {
-	ValueableTyped<size_t>::setValue (value < items_.size() ? value : (items_.empty() ? 0 : items_.size() - 1));
+	ValueableTyped<size_t>::setValue (std::min (value, getItemCount()));
+}
+
+inline void SpinBox::setValue (size_t&& value)
+{
+	setValue (static_cast<const size_t&> (value));
 }
 
 inline void SpinBox::setValue (const std::string& item)
 {
-	size_t pos = 0;
-	for (Widget* w : items_)
+	// Null item
+	if (item == "") setValue (0);
+
+	else
 	{
-		Label* l = dynamic_cast<Label*>(w);
-		if (l && l->getText() == item) break;
-		++pos;
+		const size_t pos = findItem (item);
+		if (pos != 0) setValue (pos);
 	}
+}
 
-	if (pos < items_.size()) setValue (pos);
+inline void SpinBox::setItemSource (const ItemSource* source)
+{
+	source_ = (source ? source : &items_);
+	if (top_ > getItemCount()) top_ = getItemCount();
+	if (getValue() > getItemCount()) setValue (0);
+	update();
+}
+
+inline const ItemSource* SpinBox::getItemSource () const
+{
+	return source_;
+}
+
+inline size_t SpinBox::getItemCount () const
+{
+	return source_->getItemCount();
 }
 
 inline void SpinBox::addItem (const std::string item, size_t pos)
 {
-	Label* l = new Label (0, 0, getEffectiveWidth() - buttonWidth_, itemHeight_, item);
-	if (pos >= items_.size()) items_.push_back (l);
-	else if (pos <= 1) items_.insert(std::next (items_.begin(), 1), l);
-	else items_.insert(std::next (items_.begin(), pos), l);
-	l->setBorder(BStyles::Border (BStyles::noLine, 3.0));
-	l->setEventPassable(BEvents::Event::WHEEL_SCROLL_EVENT + BEvents::Event::BUTTON_PRESS_EVENT);
-	add (l);
+	items_.insert (item, pos);
+	if (source_ != &items_) return;
+
+	if (pos < 1) pos = 1;
 	if (getValue() >= pos) setValue (getValue() + 1);
 	if (top_ >= pos) ++top_;
+	update();
 }
 
 inline void SpinBox::addItem (const std::initializer_list<const std::string> items, size_t pos)
 {
-	for (const std::string s : items)
+	for (const std::string& s : items)
 	{
 		addItem (s, pos);
 		if (pos != std::numeric_limits<size_t>::max()) ++pos;
@@ -380,50 +434,35 @@ inline void SpinBox::addItem (const std::initializer_list<const std::string> ite
 
 inline void SpinBox::deleteItem (const size_t pos)
 {
-	if ((pos > 0) && (pos < items_.size()))
-	{
-		std::list<Widget*>::iterator it = std::next (items_.begin(), pos);
-		Widget* w = *it;
-		items_.erase (it);
-		delete w;
-	}
+	items_.erase (pos);
+	if (source_ != &items_) return;
 
 	if (top_ == pos) top_ = 0;
 	else if (top_ > pos) --top_;
 	if (getValue() == pos) setValue (0);
 	else if (getValue() > pos) setValue (getValue() - 1);
+	update();
 }
 
 inline void SpinBox::deleteItem ()
 {
-	while (!items_.empty())
-	{
-		std::list<Widget*>::iterator it = std::next (items_.begin(), 1);
-		if (it == items_.end()) break;		// Don't delete Null item
-		Widget* w = *it;
-		items_.erase (it);
-		delete w;
-	}
+	items_.clear();
+	if (source_ != &items_) return;
 
 	top_ = 0;
 	setValue (0);
+	update();
 }
 
-inline Widget* SpinBox::getItem (const size_t pos) const
+inline std::string SpinBox::getItem (const size_t pos) const
 {
-	if (pos >= items_.size()) return nullptr;
-	return *std::next(items_.begin(), pos);
+	if ((pos == 0) || (pos > getItemCount())) return "";
+	return source_->getItemText (pos);
 }
 
-inline Widget* SpinBox::getItem (const std::string& item) const
+inline size_t SpinBox::findItem (const std::string& item) const
 {
-	for (std::list<Widget*>::const_iterator it = items_.begin(); it != items_.end(); ++it)
-	{
-		Label* l = dynamic_cast<Label*>(*it);
-		if (l && (l->getText() == item)) return *it;
-	}
-	
-	return nullptr;
+	return source_->findItem (item);
 }
 
 inline void SpinBox::setButtonWidth (const double width)
@@ -457,24 +496,44 @@ inline double SpinBox::getItemHeight () const
 
 inline void SpinBox::resizeItems ()
 {
-	for (Widget* w : items_) w->resize (getEffectiveWidth() - buttonWidth_, itemHeight_);
+	for (Label* l : rows_) l->resize (getEffectiveWidth() - buttonWidth_, itemHeight_);
 	update();
 }
 
-inline void SpinBox::update ()
+inline void SpinBox::allocateRows (const size_t count)
 {
-	size_t count = 0;
-	for (Widget* w : items_)
+	while (rows_.size() < count)
+	{
+		Label* l = new Label (0, 0, getEffectiveWidth() - buttonWidth_, itemHeight_, "");
+		l->setBorder(BStyles::Border (BStyles::noLine, 3.0));
+		l->setEventPassable(BEvents::Event::WHEEL_SCROLL_EVENT + BEvents::Event::BUTTON_PRESS_EVENT);
+		rows_.push_back (l);
+		add (l);
+	}
+
+	while (rows_.size() > count)
 	{
-		if (w)
-		{
-			if (getValue() == count) w->show();
-			else w->hide();
-			w->moveTo (getXOffset(), getYOffset());
-			w->resize (getEffectiveWidth() - buttonWidth_, getEffectiveHeight());
-		}
-		++count;
+		delete rows_.back();
+		rows_.pop_back();
 	}
+}
+
+inline void SpinBox::fillRow (Label* row, const size_t pos) const
+{
+	row->setText (getItem (pos));
+	if (pos != 0) source_->formatItem (pos, row);
+}
+
+inline void SpinBox::update ()
+{
+	// Only show the selected item
+	allocateRows (1);
+	Label* l = rows_.front();
+	fillRow (l, getValue());
+	l->moveTo (getXOffset(), getYOffset());
+	l->resize (getEffectiveWidth() - buttonWidth_, getEffectiveHeight());
+	l->show();
+
 	button_->moveTo (getEffectiveWidth() + getXOffset() - buttonWidth_, getYOffset());
 	button_->resize (buttonWidth_, getEffectiveHeight());
 	Widget::update();
@@ -487,7 +546,7 @@ inline void SpinBox::onWheelScrolled (BEvents::Event* event)
 	if (wev->getWidget() != this) return;
 
 	if	(((getValue() > 1) || (wev->getDelta().y > 0)) &&
-		 ((getValue() + 1 < items_.size()) || (wev->getDelta().y < 0)))
+		 ((getValue() < getItemCount()) || (wev->getDelta().y < 0)))
 	{
 		setValue (getValue() + (wev->getDelta().y < 0 ? -1 : (wev->getDelta().y > 0 ? 1 : 0)));
 	}
@@ -506,7 +565,7 @@ inline void SpinBox::valueChangedCallback (BEvents::Event* event)
 
 	if	((w == p->button_) &&
 		 ((p->getValue() > 1) || (w->getValue() > 0)) &&
-		 ((p->getValue() + 1 < p->items_.size()) || (w->getValue() < 0)))
+		 ((p->getValue() < p->getItemCount()) || (w->getValue() < 0)))
 	{
 		p->setValue (p->getValue() + w->getValue());
 	}
@@ -18,8 +18,8 @@
 #ifndef BWIDGETS_CALLBACK_HPP_
 #define BWIDGETS_CALLBACK_HPP_
 
+#include <array>
 #include <cstdint>
-#include <map>
 #include <functional>
 #include "../../BEvents/Event.hpp"
 
@@ -29,10 +29,26 @@ namespace BWidgets
 /**
  *  @brief  Callback functionality
  *
- *  The %Callback class provides callback functionality for EventTypes.
+ *  The %Callback class provides callback functionality for EventTypes. The
+ *  callback functions are stored in a fixed table with one slot per event
+ *  type bit. A bitmask flags the slots with a callback function. Thus, 
+ *  access doesn't need any search.
  */
-class Callback : protected std::map<uint8_t, std::function<void (BEvents::Event*)>>
+class Callback
 {
+public:
+
+    /**
+     *  @brief  Number of callback slots (event type bits).
+     */
+    static constexpr int nrOfSlots = 16;
+
+protected:
+    std::array<std::function<void (BEvents::Event*)>, nrOfSlots> callbacks_;
+    uint32_t callbackMask_ = 0;     // Bits of the slots with a callback function
+
+    static_assert (BEvents::Event::POINTER_FOCUS_EVENTS < (1 << nrOfSlots), "Too many event types for the callback table");
+
 public:
 
     /**
@@ -59,9 +75,13 @@ public:
 	 */
 	void setCallbackFunction (const uint32_t eventType, const std::function<void (BEvents::Event*)>& callbackFunction)
     {
-        for (uint32_t i = 0; i < 32; ++i)
+        for (int i = 0; i < nrOfSlots; ++i)
         {
-            if ((1 << i) & eventType) operator[] (i) = callbackFunction;
+            if ((1 << i) & eventType) 
+            {
+                callbacks_[i] = callbackFunction;
+                callbackMask_ |= (1 << i);
+            }
         }
     }
 
@@ -71,12 +91,12 @@ public:
 	 */
     void removeCallbackFunction (const uint32_t eventType)
     {
-        for (uint32_t i = 0; i < 32; ++i)
+        for (int i = 0; i < nrOfSlots; ++i)
         {
-            if ((1 << i) & eventType)
+            if ((1 << i) & eventType & callbackMask_)
             {
-                const_iterator cit = find (i);
-                if (cit != end()) erase (cit);
+                callbacks_[i] = nullptr;
+                callbackMask_ &= ~(1 << i);
             } 
         }
     }
@@ -84,21 +104,16 @@ public:
     /**
 	 *  @brief  Access the callback function for an event type. 
      *  @param eventType  EventType.
+     *  @return  Reference to the callback function.
      *
      *  If multiple event types are passed, then only the callback function
      *  for the first match is returned.
 	 */
-    std::function<void (BEvents::Event*)> callback (const BEvents::Event::EventType eventType) 
+    const std::function<void (BEvents::Event*)>& callback (const BEvents::Event::EventType eventType) const
     {
-        for (uint32_t i = 0; i < 32; ++i)
-        {
-            if ((1 << i) & eventType)
-            {
-                if (find(i) != end()) return operator[] (i);
-            } 
-        }
-        
-        return defaultCallback;
+        static const std::function<void (BEvents::Event*)> defaultFunction (defaultCallback);
+        const uint32_t bits = eventType & callbackMask_;
+        return (bits ? callbacks_[slot (bits)] : defaultFunction);
     }
 
     /**
@@ -106,6 +121,24 @@ public:
      *  @param event  Event.
      */
     static void defaultCallback (BEvents::Event* event) {}
+
+protected:
+
+    /**
+     *  @brief  Gets the slot of the lowest set bit.
+     *  @param bits  Bitmask, must not be 0.
+     *  @return  Slot index.
+     */
+    static int slot (const uint32_t bits)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_ctz (bits);
+#else
+        int i = 0;
+        while (!((1 << i) & bits)) ++i;
+        return i;
+#endif
+    }
 };
 
 }
@@ -19,7 +19,6 @@
 #define BWIDGETS_EVENTMERGEABLE_HPP_
 
 #include <cstdint>
-#include <map>
 #include "../../BEvents/Event.hpp"
 
 namespace BWidgets
@@ -32,7 +31,7 @@ class EventMergeable
 {
 protected:
 
-    std::map<uint8_t, bool> eventMergeable_;
+    uint32_t eventMergeable_ = 0;    // Bitmask of event types
 
 public:
 
@@ -50,10 +49,8 @@ public:
      */
     void setEventMergeable (const uint32_t eventType, const bool status) 
     {
-        for (uint32_t i = 0; i < 32; ++i)
-        {
-            if ((1 << i) & eventType) eventMergeable_[i] = status;
-        }
+        if (status) eventMergeable_ |= eventType;
+        else eventMergeable_ &= ~eventType;
     }
 
     /**
@@ -69,17 +66,8 @@ public:
      */
     bool isEventMergeable (const uint32_t eventType) const
     {
-        for (uint32_t i = 0; i < 32; ++i)
-        {
-            if ((1 << i) & eventType)
-            {
-                std::map<uint8_t, bool>::const_iterator it = eventMergeable_.find (i);
-                if (it == eventMergeable_.end()) return false;
-                return it->second;
-            }
-        }
-
-        return false;
+        // First event type (lowest bit) only
+        return (eventMergeable_ & eventType & (~eventType + 1));
     }
 
 };
@@ -19,7 +19,6 @@
 #define BWIDGETS_EVENTPASSABLE_HPP_
 
 #include <cstdint>
-#include <map>
 #include "../../BEvents/Event.hpp"
 
 namespace BWidgets
@@ -41,7 +40,7 @@ class EventPassable
 {
 protected:
 
-    std::map<uint8_t, bool> eventPassable_;
+    uint32_t eventPassable_ = 0;    // Bitmask of event types
 
 public:
 
@@ -55,10 +54,8 @@ public:
      */
     void setEventPassable (const uint32_t eventType, bool status = true) 
     {
-        for (uint32_t i = 0; i < 32; ++i)
-        {
-            if ((1 << i) & eventType) eventPassable_[i] = status;
-        }
+        if (status) eventPassable_ |= eventType;
+        else eventPassable_ &= ~eventType;
     }
 
     /**
@@ -74,17 +71,8 @@ public:
      */
     bool isEventPassable (const uint32_t eventType) const
     {
-        for (uint32_t i = 0; i < 32; ++i)
-        {
-            if ((1 << i) & eventType)
-            {
-                std::map<uint8_t, bool>::const_iterator it = eventPassable_.find (i);
-                if (it == eventPassable_.end()) return false;
-                return it->second;
-            }
-        }
-
-        return false;
+        // First event type (lowest bit) only
+        return (eventPassable_ & eventType & (~eventType + 1));
     }
 
 };
@@ -19,7 +19,8 @@
 #define BWIDGETS_LINKABLE_HPP_
 
 #include <algorithm>
-#include <list>
+#include <cstddef>
+#include <vector>
 #include <functional>
 #include "Support.hpp"
 
@@ -29,6 +30,12 @@ namespace BWidgets
 /**
  *  @brief  Support for linking to parent and child objects.
  *
+ *  The children are stored in a vector in the order of their addition (or
+ *  rearrangement). Each child object knows its index within its parent. 
+ *  Thus, lookup of a child doesn't need any search. Releasing the last 
+ *  child object is O(1). Releasing or moving other child objects only
+ *  shifts the subsequent child pointers.
+ *
  *  Note: The class %Linkable is devoid of any copy constructor or assignment
  *  operator.
  */
@@ -37,7 +44,8 @@ class Linkable : public Support
 protected:
     Linkable* parent_;
 	Linkable* main_;
-    std::list<Linkable*> children_;
+    std::vector<Linkable*> children_;
+    size_t childIndex_;     // Index within parent_->children_
 
 public:
 	Linkable ();
@@ -67,7 +75,8 @@ public:
 	 *  @param child  Pointer to the child object.
 	 *  @param addfunc  Optional, function to be executed once a child object
 	 *  is added.
-	 *  @return  Iterator for the inserted child.
+	 *  @return  Iterator for the inserted child. Invalidated by the next
+	 *  change of the children.
 	 *
 	 *  New child objects are appended to the end of list of children objects
 	 *  (see @c getChildren() ).
@@ -75,7 +84,7 @@ public:
 	 *  Returns @c getChildren().end() if noting inserted (e.g, trying to add
 	 *  a @c nullptr or linking is switched off).
 	 */
-	virtual std::list<Linkable*>::iterator 
+	virtual std::vector<Linkable*>::iterator 
 	add	(Linkable* child, std::function<void (Linkable* obj)> addfunc = [] (Linkable* obj) {});
 
 	/**
@@ -127,14 +136,20 @@ public:
 	/**
 	 *  @brief  Read-only access to the list of children pointers. 
 	 *  @return  Reference to the children list.
+	 *
+	 *  Use @c add() , @c release() , and @c moveChild() to change the
+	 *  children list.
 	 */
-	const std::list<Linkable*>& getChildren () const;
+	const std::vector<Linkable*>& getChildren () const;
 
 	/**
-	 *  @brief  Access to the list of children pointers. 
-	 *  @return  Reference to the children list.
+	 *  @brief  Moves a child object to a new position within the children
+	 *  list.
+	 *  @param child  Pointer to the child object.
+	 *  @param position  New position. Positions behind the end move the 
+	 *  child to the end.
 	 */
-	std::list<Linkable*>& getChildren ();
+	void moveChild (Linkable* child, const size_t position);
 
 	/**
 	 *  @brief  (Recursive) iteration over all child objects.
@@ -149,6 +164,28 @@ public:
 	 *  performed. Returns true for recursion, otherwise false.
 	 */
 	void forEachChild	(std::function<bool (Linkable* obj)> func = [] (Linkable* obj) {return true;}) const;
+
+	/**
+	 *  @brief  (Recursive) iteration over all child objects using a visitor.
+	 *  @tparam F  Callable type bool (Linkable* obj).
+	 *  @param func  Visitor to check if recursive iteration will be 
+	 *  performed. Returns true for recursion, otherwise false.
+	 *
+	 *  Calls @a func directly without type erasure (std::function) and
+	 *  without copying.
+	 */
+	template <class F>
+	void forEachChild	(F&& func);
+
+	/**
+	 *  @brief  (Recursive) read-only iteration over all child objects using a
+	 *  visitor.
+	 *  @tparam F  Callable type bool (Linkable* obj).
+	 *  @param func  Visitor to check if recursive iteration will be 
+	 *  performed. Returns true for recursion, otherwise false.
+	 */
+	template <class F>
+	void forEachChild	(F&& func) const;
 	
 	/**
 	 *  @brief  (Recursive) iteration over a selected section of child objects.
@@ -157,8 +194,8 @@ public:
 	 *  @param func  Function to check if recursive iteration will be 
 	 *  performed. Returns true for recursion, otherwise false.
 	 */
-	void forEachChild	(std::list<Linkable*>::iterator first, 
-						 std::list<Linkable*>::iterator last,
+	void forEachChild	(std::vector<Linkable*>::iterator first, 
+						 std::vector<Linkable*>::iterator last,
 						 std::function<bool (Linkable* obj)> func = [] (Linkable* obj) {return true;});
 
 	/**
@@ -169,17 +206,28 @@ public:
 	 *  @param func  Function to check if recursive iteration will be 
 	 *  performed. Returns true for recursion, otherwise false.
 	 */
-	void forEachChild	(std::list<Linkable*>::const_iterator first, 
-						 std::list<Linkable*>::const_iterator last,
+	void forEachChild	(std::vector<Linkable*>::const_iterator first, 
+						 std::vector<Linkable*>::const_iterator last,
 						 std::function<bool (Linkable* obj)> func = [] (Linkable* obj) {return true;}) const;
 
+protected:
+
+	/**
+	 *  @brief  Updates the indexes of the children stored in the children
+	 *  list.
+	 *  @param first  Position of the first child to be updated.
+	 *  @param last  Position past the last child to be updated.
+	 */
+	void reindexChildren (const size_t first, const size_t last);
+
 };
 
 inline Linkable::Linkable () :
 	Support(),
     parent_ (nullptr),
 	main_ (this),
-    children_ ()
+    children_ (),
+	childIndex_ (0)
 {
 
 }
@@ -209,7 +257,7 @@ inline bool Linkable::isLinkable () const
 	return getSupport();
 }
 
-inline std::list<Linkable*>::iterator Linkable::add	(Linkable* child,
+inline std::vector<Linkable*>::iterator Linkable::add	(Linkable* child,
 												 std::function<void (Linkable* obj)> addfunc)
 {
 	if (!isLinkable()) return children_.end();
@@ -220,6 +268,7 @@ inline std::list<Linkable*>::iterator Linkable::add	(Linkable* child,
 
 	// Connect child and add child to list
 	child->parent_ = this;
+	child->childIndex_ = children_.size();
 	children_.push_back (child);
 
 	// Connect child and children of child to main_
@@ -245,27 +294,27 @@ inline void Linkable::release (std::function<void (Linkable* obj)> releasefunc)
 
 inline void Linkable::release (Linkable* child, std::function<void (Linkable* obj)> releasefunc)
 {
-	if (child)
+	if (contains (child))
 	{
-		std::list<Linkable*>::iterator it = std::find (children_.begin(), children_.end(), child);
-
-		if (it != children_.end())
-		{
-			forEachChild 
-			(
-				it, 
-				std::next (it), 
-				[child, releasefunc] (Linkable* l)
-				{
-					releasefunc (l);
-					l->main_ = child;
-					return true;
-				}
-			);
-
-			child->parent_ = nullptr;
-			children_.erase (it);
-		}
+		const size_t index = child->childIndex_;
+		std::vector<Linkable*>::iterator it = children_.begin() + index;
+
+		forEachChild 
+		(
+			it, 
+			std::next (it), 
+			[child, releasefunc] (Linkable* l)
+			{
+				releasefunc (l);
+				l->main_ = child;
+				return true;
+			}
+		);
+
+		child->parent_ = nullptr;
+		child->childIndex_ = 0;
+		children_.erase (children_.begin() + index);
+		reindexChildren (index, children_.size());
 	}
 }
 
@@ -286,17 +335,30 @@ inline bool Linkable::hasChildren () const
 
 inline bool Linkable::contains (const Linkable* child) const
 {
-	return std::find (children_.begin(), children_.end(), child) != children_.end();
+	return child && (child->parent_ == this);
 }
 
-inline const std::list<Linkable*>& Linkable::getChildren () const
+inline const std::vector<Linkable*>& Linkable::getChildren () const
 {
 	return children_;
 }
 
-inline std::list<Linkable*>& Linkable::getChildren ()
+inline void Linkable::moveChild (Linkable* child, const size_t position)
 {
-	return children_;
+	if (!contains (child)) return;
+
+	const size_t from = child->childIndex_;
+	const size_t to = std::min (position, children_.size() - 1);
+	if (from < to) std::rotate (children_.begin() + from, children_.begin() + from + 1, children_.begin() + to + 1);
+	else if (from > to) std::rotate (children_.begin() + to, children_.begin() + from, children_.begin() + from + 1);
+	else return;
+
+	reindexChildren (std::min (from, to), std::max (from, to) + 1);
+}
+
+inline void Linkable::reindexChildren (const size_t first, const size_t last)
+{
+	for (size_t i = first; (i < last) && (i < children_.size()); ++i) children_[i]->childIndex_ = i;
 }
 
 inline void Linkable::forEachChild	(std::function<bool (Linkable* obj)> func)
@@ -309,22 +371,42 @@ inline void Linkable::forEachChild	(std::function<bool (Linkable* obj)> func) co
 	forEachChild (children_.begin(), children_.end(), func);
 }
 	
-inline void Linkable::forEachChild	(std::list<Linkable*>::iterator first, 
-					 		 std::list<Linkable*>::iterator last,
+template <class F>
+inline void Linkable::forEachChild	(F&& func)
+{
+	for (size_t i = 0; i < children_.size(); ++i)
+	{
+		Linkable* l = children_[i];
+		if (l && func (l)) l->forEachChild (func);
+	}
+}
+
+template <class F>
+inline void Linkable::forEachChild	(F&& func) const
+{
+	for (size_t i = 0; i < children_.size(); ++i)
+	{
+		Linkable* l = children_[i];
+		if (l && func (l)) static_cast<const Linkable*>(l)->forEachChild (func);
+	}
+}
+	
+inline void Linkable::forEachChild	(std::vector<Linkable*>::iterator first, 
+					 		 std::vector<Linkable*>::iterator last,
 					 		 std::function<bool (Linkable* obj)> func)
 {
-	for (std::list<Linkable*>::iterator it = first; it != last; ++it)
+	for (std::vector<Linkable*>::iterator it = first; it != last; ++it)
 	{
 		Linkable* l = *it;
 		if (l && func (l)) l->forEachChild (func);
 	}
 }
 
-inline void Linkable::forEachChild	(std::list<Linkable*>::const_iterator first, 
-					 		 std::list<Linkable*>::const_iterator last,
+inline void Linkable::forEachChild	(std::vector<Linkable*>::const_iterator first, 
+					 		 std::vector<Linkable*>::const_iterator last,
 					 		 std::function<bool (Linkable* obj)> func) const
 {
-	for (std::list<Linkable*>::const_iterator it = first; it != last; ++it)
+	for (std::vector<Linkable*>::const_iterator it = first; it != last; ++it)
 	{
 		Linkable* l = *it;
 		if (l && func (l)) l->forEachChild (func);
@@ -0,0 +1,322 @@
+/* MeterFeedable.hpp
+ * Copyright (C) 2018 - 2022  Sven Jähnichen
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef BWIDGETS_METERFEEDABLE_HPP_
+#define BWIDGETS_METERFEEDABLE_HPP_
+
+#include "Pollable.hpp"
+#include "../../BUtilities/RingBuffer.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+
+#ifndef BWIDGETS_DEFAULT_METERFEEDABLE_BUFFER_SIZE
+#define BWIDGETS_DEFAULT_METERFEEDABLE_BUFFER_SIZE 256
+#endif
+
+#ifndef BWIDGETS_DEFAULT_METERFEEDABLE_DECAY
+#define BWIDGETS_DEFAULT_METERFEEDABLE_DECAY 12.0
+#endif
+
+#ifndef BWIDGETS_DEFAULT_METERFEEDABLE_PEAKHOLD
+#define BWIDGETS_DEFAULT_METERFEEDABLE_PEAKHOLD 1.5
+#endif
+
+#ifndef BWIDGETS_DEFAULT_METERFEEDABLE_FLOOR
+#define BWIDGETS_DEFAULT_METERFEEDABLE_FLOOR 0.00001
+#endif
+
+namespace BWidgets
+{
+
+/**
+ *  @brief  Support to feed audio data into a meter from any thread.
+ *
+ *  Audio samples or pre-calculated levels can be fed in blocks using
+ *  @c feedSamples() or @c feedLevel() from a single producer thread (e.g.,
+ *  the DSP thread) without locks or memory allocation. The main window
+ *  polls @c processFeed() once per frame. This evaluates all blocks fed
+ *  since the last call, applies decay and peak hold, and publishes the
+ *  resulting level and peak hold level to the widget only once via
+ *  @c publishLevel() . Thus, the GUI costs only depend on the frame rate,
+ *  not on the audio block rate.
+ */
+class MeterFeedable : public Pollable
+{
+public:
+
+    /**
+     *  @brief  Enumeration of level calculation modes.
+     */
+    enum LevelMode
+    {
+        PEAK_LEVEL,
+        RMS_LEVEL
+    };
+
+protected:
+
+    struct Block
+    {
+        float peak;
+        double sumSq;
+        uint32_t count;
+    };
+
+    BUtilities::RingBuffer<Block, BWIDGETS_DEFAULT_METERFEEDABLE_BUFFER_SIZE> feed_;
+    LevelMode levelMode_;
+    double decay_;
+    double peakHoldTime_;
+    double level_;
+    double peakHold_;
+    bool feedActive_;
+    std::chrono::steady_clock::time_point feedTime_;
+    std::chrono::steady_clock::time_point peakHoldTime0_;
+
+public:
+
+    /**
+     *  @brief  Constructs a default %MeterFeedable object.
+     */
+    MeterFeedable () :
+        Pollable (),
+        feed_ (),
+        levelMode_ (PEAK_LEVEL),
+        decay_ (BWIDGETS_DEFAULT_METERFEEDABLE_DECAY),
+        peakHoldTime_ (BWIDGETS_DEFAULT_METERFEEDABLE_PEAKHOLD),
+        level_ (0.0),
+        peakHold_ (0.0),
+        feedActive_ (false),
+        feedTime_ (std::chrono::steady_clock::now()),
+        peakHoldTime0_ (feedTime_)
+    {
+
+    }
+
+    /**
+     *  @brief  Constructs a %MeterFeedable object with the settings of 
+     *  another one. Neither fed data nor levels are copied.
+     *  @param that  Other %MeterFeedable object.
+     */
+    MeterFeedable (const MeterFeedable& that) :
+        Pollable (that),
+        feed_ (),
+        levelMode_ (that.levelMode_),
+        decay_ (that.decay_),
+        peakHoldTime_ (that.peakHoldTime_),
+        level_ (0.0),
+        peakHold_ (0.0),
+        feedActive_ (false),
+        feedTime_ (std::chrono::steady_clock::now()),
+        peakHoldTime0_ (feedTime_)
+    {
+
+    }
+
+    /**
+     *  @brief  Copies the settings from another %MeterFeedable object.
+     *  Neither fed data nor levels are copied.
+     *  @param that  Other %MeterFeedable object.
+     */
+    MeterFeedable& operator= (const MeterFeedable& that)
+    {
+        Pollable::operator= (that);
+        levelMode_ = that.levelMode_;
+        decay_ = that.decay_;
+        peakHoldTime_ = that.peakHoldTime_;
+        return *this;
+    }
+
+    /**
+     *  @brief  Switch the meter feed support on/off.
+     *  @param status  True if on, otherwise false.
+     */
+    void setMeterFeedable (const bool status) {setSupport (status);}
+
+    /**
+     *  @brief  Information about the meter feed support.
+     *  @return  True if on, otherwise false.
+     */
+    bool isMeterFeedable () const {return getSupport();}
+
+    /**
+     *  @brief  Feeds a block of audio samples. Producer thread only.
+     *  @param samples  Pointer to the samples.
+     *  @param count  Number of samples.
+     *  @return  True on success, false if the feed buffer is full.
+     *
+     *  Only peak and sum of squares of the block are stored. Blocks are
+     *  dropped if the feed buffer is full (e.g., if the GUI is closed).
+     */
+    bool feedSamples (const float* samples, const size_t count)
+    {
+        if ((!samples) || (count == 0)) return true;
+
+        float peak = 0.0f;
+        double sumSq = 0.0;
+        for (size_t i = 0; i < count; ++i)
+        {
+            const float a = std::fabs (samples[i]);
+            if (a > peak) peak = a;
+            sumSq += double (samples[i]) * double (samples[i]);
+        }
+
+        return feed_.push (Block {peak, sumSq, uint32_t (count)});
+    }
+
+    /**
+     *  @brief  Feeds a pre-calculated level. Producer thread only.
+     *  @param level  Level (linear, >= 0).
+     *  @return  True on success, false if the feed buffer is full.
+     */
+    bool feedLevel (const float level)
+    {
+        return feed_.push (Block {std::fabs (level), double (level) * double (level), 1});
+    }
+
+    /**
+     *  @brief  Sets the level calculation mode.
+     *  @param mode  PEAK_LEVEL or RMS_LEVEL.
+     */
+    void setLevelMode (const LevelMode mode) {levelMode_ = mode;}
+
+    /**
+     *  @brief  Gets the level calculation mode.
+     *  @return  PEAK_LEVEL or RMS_LEVEL.
+     */
+    LevelMode getLevelMode () const {return levelMode_;}
+
+    /**
+     *  @brief  Sets the decay (fall back) rate.
+     *  @param dbPerSecond  Decay in dB per second. 0.0 for no decay.
+     */
+    void setDecay (const double dbPerSecond) {decay_ = dbPerSecond;}
+
+    /**
+     *  @brief  Gets the decay (fall back) rate.
+     *  @return  Decay in dB per second.
+     */
+    double getDecay () const {return decay_;}
+
+    /**
+     *  @brief  Sets the peak hold time.
+     *  @param seconds  Time in seconds.
+     */
+    void setPeakHoldTime (const double seconds) {peakHoldTime_ = seconds;}
+
+    /**
+     *  @brief  Gets the peak hold time.
+     *  @return  Time in seconds.
+     */
+    double getPeakHoldTime () const {return peakHoldTime_;}
+
+    /**
+     *  @brief  Gets the last published level.
+     *  @return  Level.
+     */
+    double getLevel () const {return level_;}
+
+    /**
+     *  @brief  Gets the current peak hold level.
+     *  @return  Peak hold level.
+     */
+    double getPeakHold () const {return peakHold_;}
+
+    /**
+     *  @brief  Processes all data fed since the last call and publishes the
+     *  result. GUI thread only.
+     *
+     *  Called by @c poll() once per frame. Calls @c publishLevel() if the
+     *  level or the peak hold level changed.
+     */
+    void processFeed ()
+    {
+        const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        const double dt = std::chrono::duration<double> (now - feedTime_).count();
+        feedTime_ = now;
+
+        // Collect fed blocks
+        Block b;
+        float peak = 0.0f;
+        double sumSq = 0.0;
+        size_t count = 0;
+        bool fed = false;
+        while (feed_.pop (b))
+        {
+            fed = true;
+            if (b.peak > peak) peak = b.peak;
+            sumSq += b.sumSq;
+            count += b.count;
+        }
+
+        if ((!fed) && (!feedActive_)) return;
+        feedActive_ = true;
+
+        // Level and decay
+        const double fall = (decay_ > 0.0 ? std::pow (10.0, -0.05 * decay_ * dt) : 1.0);
+        const double input = (levelMode_ == RMS_LEVEL ? (count ? std::sqrt (sumSq / count) : 0.0) : peak);
+        double level = (decay_ > 0.0 ? std::max (input, level_ * fall) : (fed ? input : level_));
+
+        // Peak hold
+        const double hold = peakHold_;
+        if (peak >= peakHold_)
+        {
+            peakHold_ = peak;
+            peakHoldTime0_ = now;
+        }
+        else if (std::chrono::duration<double> (now - peakHoldTime0_).count() > peakHoldTime_)
+        {
+            peakHold_ = std::max (double (peak), peakHold_ * fall);
+        }
+
+        // Stop processing if silent
+        if ((!fed) && (level < BWIDGETS_DEFAULT_METERFEEDABLE_FLOOR) && (peakHold_ < BWIDGETS_DEFAULT_METERFEEDABLE_FLOOR))
+        {
+            level = 0.0;
+            peakHold_ = 0.0;
+            feedActive_ = false;
+        }
+
+        if ((level != level_) || (peakHold_ != hold))
+        {
+            level_ = level;
+            publishLevel (level_, peakHold_);
+        }
+    }
+
+    /**
+     *  @brief  Method called by the main window once per frame. Processes
+     *  the feed.
+     */
+    virtual void poll () override {processFeed ();}
+
+protected:
+
+    /**
+     *  @brief  Publishes a processed level to the widget.
+     *  @param level  Level.
+     *  @param hold  Peak hold level.
+     *
+     *  Called from @c processFeed() (GUI thread).
+     */
+    virtual void publishLevel (const double level, const double hold) = 0;
+};
+
+}
+
+#endif /* BWIDGETS_METERFEEDABLE_HPP_ */
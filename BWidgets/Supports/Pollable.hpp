@@ -0,0 +1,61 @@
+/* Pollable.hpp
+ * Copyright (C) 2018 - 2022  Sven Jähnichen
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef BWIDGETS_POLLABLE_HPP_
+#define BWIDGETS_POLLABLE_HPP_
+
+#include "Support.hpp"
+
+namespace BWidgets
+{
+
+/**
+ *  @brief  Support to be polled by the main window once per frame.
+ *
+ *  Pollable objects can collect data produced by other threads (e.g., fed
+ *  audio data, results of background tasks) in the GUI thread without
+ *  events. The main window calls @c poll() of each linked %Pollable
+ *  widget once per frame (see @c Window::setMaxFps() ). Widgets are
+ *  registered upon linking to the main window (see
+ *  @c Window::addPollable() ).
+ */
+class Pollable : public Support
+{
+public:
+
+    /**
+     *  @brief  Switch the poll support on/off.
+     *  @param status  True if on, otherwise false.
+     */
+    void setPollable (const bool status) {setSupport (status);}
+
+    /**
+     *  @brief  Information about the poll support.
+     *  @return  True if on, otherwise false.
+     */
+    bool isPollable () const {return getSupport();}
+
+    /**
+     *  @brief  Method called by the main window once per frame. GUI thread
+     *  only.
+     */
+    virtual void poll () = 0;
+};
+
+}
+
+#endif /* BWIDGETS_POLLABLE_HPP_ */
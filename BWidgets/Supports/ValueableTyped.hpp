@@ -24,12 +24,18 @@
 #include "../Window.hpp"
 #include "../../BEvents/ValueChangeTypedEvent.hpp"
 
+#include <utility>
+
 namespace BWidgets
 {
 
 /**
  *  @brief  Supports a value and value changed events.
  *  @tparam T  Value type.
+ *
+ *  Pointers to the Widget and to the Validatable<T> interface of this object
+ *  are resolved upon the first value change and cached. Classes which
+ *  override @c setValue(const T&) MUST also override @c setValue(T&&) .
  */
 template <class T>
 class ValueableTyped : public Valueable
@@ -37,6 +43,11 @@ class ValueableTyped : public Valueable
 protected:
     T value_;
 
+private:
+    Widget* widget_;
+    Validatable<T>* validatable_;
+    bool resolved_;
+
 public:
 
     typedef T value_type;
@@ -52,6 +63,23 @@ public:
      */
     ValueableTyped (const T& value);
 
+    /**
+     *  @brief  Constructs a copy of a %ValueableTyped object.
+     *  @param that  Other object.
+     *
+     *  Copies the value, but not the cached interfaces.
+     */
+    ValueableTyped (const ValueableTyped<T>& that);
+
+    /**
+     *  @brief  Assigns the value of another %ValueableTyped object.
+     *  @param that  Other object.
+     *
+     *  Copies the value, but not the cached interfaces. Doesn't emit an
+     *  event.
+     */
+    ValueableTyped<T>& operator= (const ValueableTyped<T>& that);
+
     /**
      *  @brief  Copiess the value from another %ValueableTyped object.
      *  @param that  Other object.
@@ -68,6 +96,15 @@ public:
      */
     virtual void setValue (const T& value);
 
+    /**
+     *  @brief  Changes the value by moving.
+     *  @param value  Value.
+     *
+     *  Also emits a ValueChangeTyped<T> event. Unvalidated values are moved
+     *  into the object without a copy.
+     */
+    virtual void setValue (T&& value);
+
     /**
      *  @brief  Gets the value.
      *  @return  Value. 
@@ -82,6 +119,10 @@ public:
 	 */
     void emitValueChanged ();
 
+private:
+    void resolve ();
+    void setValidValue (T&& value);
+    void changed ();
 };
 
 template<class T>
@@ -94,11 +135,33 @@ ValueableTyped<T>::ValueableTyped () :
 template<class T>
 ValueableTyped<T>::ValueableTyped (const T& value) :
     Valueable (),
-    value_ (value)
+    value_ (value),
+    widget_ (nullptr),
+    validatable_ (nullptr),
+    resolved_ (false)
 {
 
 }
 
+template<class T>
+ValueableTyped<T>::ValueableTyped (const ValueableTyped<T>& that) :
+    Valueable (that),
+    value_ (that.value_),
+    widget_ (nullptr),
+    validatable_ (nullptr),
+    resolved_ (false)
+{
+
+}
+
+template<class T>
+ValueableTyped<T>& ValueableTyped<T>::operator= (const ValueableTyped<T>& that)
+{
+    Valueable::operator= (that);
+    value_ = that.value_;
+    return *this;
+}
+
 template<class T>
 void ValueableTyped<T>::setValue (const ValueableTyped<T>& that)
 {
@@ -108,19 +171,33 @@ void ValueableTyped<T>::setValue (const ValueableTyped<T>& that)
 template<class T>
 void ValueableTyped<T>::setValue (const T& value)
 {
+    resolve ();
+
     // Validate
-    Validatable<T>* validatable = dynamic_cast<Validatable<T>*>(this);
-    T nval = (validatable && validatable->isValidatable() ? validatable->validate (value) : value);
+    if (validatable_ && validatable_->isValidatable())
+    {
+        setValidValue (validatable_->validate (value));
+        return;
+    }
 
     // Set new value_
-    if (value_ != nval)
+    if (value_ != value)
     {
-        value_ = nval;
-        emitValueChanged();
-        if (dynamic_cast<Widget*>(this)) dynamic_cast<Widget*>(this)->update();
+        value_ = value;
+        changed ();
     }
 }
 
+template<class T>
+void ValueableTyped<T>::setValue (T&& value)
+{
+    resolve ();
+
+    // Validate
+    if (validatable_ && validatable_->isValidatable()) setValidValue (validatable_->validate (value));
+    else setValidValue (std::move (value));
+}
+
 template<class T>
 T ValueableTyped<T>::getValue () const
 {
@@ -130,15 +207,44 @@ T ValueableTyped<T>::getValue () const
 template<class T>
 void ValueableTyped<T>::emitValueChanged ()
 {
-    Widget* thisWidget = dynamic_cast<Widget*>(this);
-    if (!thisWidget) return;
+    resolve ();
+    if (!widget_) return;
     
-    if (thisWidget->getMainWindow())
+    Window* window = widget_->getMainWindow();
+    if (window)
 	{
-		BEvents::ValueChangeTypedEvent<T>* event = new BEvents::ValueChangeTypedEvent<T> (thisWidget, value_);
-		thisWidget->getMainWindow()->addEventToQueue (event);
+		BEvents::ValueChangeTypedEvent<T>* event = new BEvents::ValueChangeTypedEvent<T> (widget_, std::make_shared<const T> (value_));
+		window->addEventToQueue (event);
 	}
 }
 
+template<class T>
+void ValueableTyped<T>::resolve ()
+{
+    // Can't be done in the constructor: The derived parts don't exist yet
+    if (resolved_) return;
+    widget_ = dynamic_cast<Widget*>(this);
+    validatable_ = dynamic_cast<Validatable<T>*>(this);
+    resolved_ = true;
+}
+
+template<class T>
+void ValueableTyped<T>::setValidValue (T&& value)
+{
+    // Set new value_
+    if (value_ != value)
+    {
+        value_ = std::move (value);
+        changed ();
+    }
+}
+
+template<class T>
+void ValueableTyped<T>::changed ()
+{
+    emitValueChanged();
+    if (widget_) widget_->update();
+}
+
 }
-#endif /* BWIDGETS_VALUEABLETYPED_HPP_ */
\ No newline at end of file
+#endif /* BWIDGETS_VALUEABLETYPED_HPP_ */
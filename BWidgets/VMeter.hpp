@@ -22,6 +22,7 @@
 #define BWIDGETS_DEFAULT_DRAWVMETER_PATH "Draws/drawVMeter.hpp"
 #endif
 
+#include "Draws/meterSegmentColors.hpp"
 #include BWIDGETS_DEFAULT_DRAWVMETER_PATH
 #include "Widget.hpp"
 #include "Label.hpp"
@@ -29,8 +30,10 @@
 #include "Supports/ValueableTyped.hpp"
 #include "Supports/ValidatableRange.hpp"
 #include "Supports/ValueTransferable.hpp"
+#include "Supports/MeterFeedable.hpp"
 #include <cairo/cairo.h>
 #include <cmath>
+#include <algorithm>
 
 #ifndef BWIDGETS_DEFAULT_VMETER_WIDTH
 #define BWIDGETS_DEFAULT_VMETER_WIDTH 20.0
@@ -59,15 +62,35 @@ namespace BWidgets
  *  Advanced settings allow a %VMeter to display a value in a non-linear
  *  manner (e.g. for levels and frequencies) using transfer functions and / or
  *  to use non-line color gradients for display using gradient functions. 
+ *
+ *  Audio data can also be fed from the DSP thread via MeterFeedable. The
+ *  resulting level is set as value once per main window cycle.
  */
 class VMeter :	public Widget, 
 				public ValueableTyped<double>, 
 				public ValidatableRange<double>, 
-				public ValueTransferable<double>
+				public ValueTransferable<double>,
+				public MeterFeedable
 {
 protected:
 	BUtilities::Area<> scale_;
 	std::function<double (const double& x)> gradient_ = noTransfer;
+	cairo_surface_t* staticSurface_;
+	BUtilities::Area<> staticScale_;
+	double staticStep_;
+	BStyles::Color staticBgColor_;
+	std::vector<MeterSegmentColor> segmentColors_;
+	double segmentStep_;
+	BStyles::Color segmentLoColor_;
+	BStyles::Color segmentHiColor_;
+	bool incremental_;
+	bool valueChanging_;
+	bool fullDraw_;
+	double drawnPos_;
+	double hold_;
+	double drawnHold_;
+	double damageLo_;
+	double damageHi_;
 
 public:
 
@@ -119,6 +142,8 @@ public:
 			 std::function<double (const double& x)> reTransferFunc = ValueTransferable<double>::noTransfer,
 			 uint32_t urid = URID_UNKNOWN_URID, std::string title = "");
 
+	virtual ~VMeter();
+
 	/**
 	 *  @brief  Creates a clone of the %VMeter. 
 	 *  @return  Pointer to the new %VMeter.
@@ -166,6 +191,26 @@ public:
      */
     virtual void update () override;
 
+	/**
+	 *  @brief  Changes the value.
+	 *  @param value  Value.
+	 *
+	 *  Also emits a ValueChangeTyped<double> event. Value changes only result
+	 *  in an incremental redraw of the segments between the previously drawn
+	 *  and the new value if possible.
+	 */
+	virtual void setValue (const double& value) override;
+
+	/**
+	 *  @brief  Changes the value.
+	 *  @param value  Value.
+	 *
+	 *  Equivalent to @c setValue(const double&) .
+	 */
+	virtual void setValue (double&& value) override;
+
+	using ValueableTyped<double>::setValue;
+
 	/**
      *  @brief  Gets the high range value colors Property from the base level.
      *  @return  High range value ColorMap.
@@ -196,10 +241,95 @@ public:
 	void setGradientFunction (std::function<double (const double& x)> gradientFunc)
 	{
 		gradient_ = gradientFunc;
+		segmentColors_.clear();
 	}
 
 protected:
 	/**
+	 *  @brief  Publishes a level processed from the meter feed.
+	 *  @param level  Level.
+	 *  @param hold  Peak hold level.
+	 *
+	 *  Sets the value to @a level and shows a peak hold marker at @a hold .
+	 */
+	virtual void publishLevel (const double level, const double hold) override;
+
+	/**
+	 *  @brief  Gets the relative position of the peak hold marker.
+	 *  @return  Position [0..1], or -1.0 if no marker is shown.
+	 */
+	double getHoldPos () const;
+
+	/**
+	 *  @brief  Draws the peak hold marker segment.
+	 *  @param cr  Cairo context.
+	 *  @param step  Relative size of each segment.
+	 *  @param colors  Segment color lookup table.
+	 */
+	void drawHold (cairo_t* cr, const double step, const std::vector<MeterSegmentColor>& colors);
+
+	/**
+	 *  @brief  Renders the static elements of the %VMeter to the static
+	 *  surface.
+	 *  @param step  Relative size of each segment.
+	 *  @param bgColor  Bar RGBA color.
+	 *
+	 *  The static surface keeps the value-independent elements (background,
+	 *  border, and inactive segments) and is blitted on each draw. It is
+	 *  only re-rendered if the widget extends, the scale, @a step, or
+	 *  @a bgColor changed since the last call.
+	 */
+	void drawStatic (const double step, const BStyles::Color& bgColor);
+
+	/**
+	 *  @brief  Gets the segment color lookup table.
+	 *  @param step  Relative size of each segment.
+	 *  @param loColor  RGBA color for the low values.
+	 *  @param hiColor  RGBA color for the high values.
+	 *  @return  Reference to the segment color lookup table.
+	 *
+	 *  The table is only re-calculated if @a step, @a loColor, @a hiColor,
+	 *  or the gradient function changed since the last call.
+	 */
+	const std::vector<MeterSegmentColor>& getSegmentColors (const double step, const BStyles::Color& loColor, const BStyles::Color& hiColor);
+
+	/**
+	 *  @brief  Gets the relative size of each segment.
+	 *  @return  Relative segment size.
+	 */
+	double getSegmentStep () const;
+
+	/**
+	 *  @brief  Gets the area covered by a range of segments.
+	 *  @param from  Relative start position [0..1].
+	 *  @param to  Relative end position [0..1].
+	 *  @return  Segment area (relative to the widget).
+	 */
+	BUtilities::Area<> getSegmentArea (const double from, const double to) const;
+
+	/**
+	 *  @brief  Tries to schedule an incremental draw following a value 
+	 *  change.
+	 *  @param scale  New scale area.
+	 *  @return  True if an incremental draw is scheduled, otherwise false.
+	 *
+	 *  An incremental draw is only possible if just the value changed since
+	 *  the last draw (same @a scale, status, and opaque bar colors). Then
+	 *  only the segment range between the previously drawn and the new value
+	 *  is marked as damaged and exposed. Otherwise a full redraw is marked
+	 *  and the caller has to call @c Widget::update() .
+	 *
+	 *  Derived classes which override @c draw() without drawing meter 
+	 *  segments must set @c incremental_ to false.
+	 */
+	bool scheduleIncrementalDraw (const BUtilities::Area<>& scale);
+
+	/**
+	 *  @brief  Redraws the damaged segment range only.
+	 */
+	void drawIncremental ();
+
+	/**
      *  @brief  Unclipped draw a %VMeter to the surface.
      */
     virtual void draw () override;
@@ -256,11 +386,32 @@ inline VMeter::VMeter	(const double  x, const double y, const double width, cons
 	ValueableTyped<double> (value),
 	ValidatableRange<double> (min, max, step),
 	ValueTransferable<double> (transferFunc, reTransferFunc),
-	scale_ (0, 0, width, height)
+	scale_ (0, 0, width, height),
+	staticSurface_ (nullptr),
+	staticScale_ (),
+	staticStep_ (0.0),
+	staticBgColor_ (),
+	segmentColors_ (),
+	segmentStep_ (0.0),
+	segmentLoColor_ (),
+	segmentHiColor_ (),
+	incremental_ (true),
+	valueChanging_ (false),
+	fullDraw_ (true),
+	drawnPos_ (-1.0),
+	hold_ (0.0),
+	drawnHold_ (-1.0),
+	damageLo_ (1.0),
+	damageHi_ (0.0)
 {
 
 }
 
+inline VMeter::~VMeter()
+{
+	if (staticSurface_) cairo_surface_destroy (staticSurface_);
+}
+
 inline Widget* VMeter::clone () const 
 {
 	Widget* f = new VMeter (urid_, title_);
@@ -272,7 +423,13 @@ inline void VMeter::copy (const VMeter* that)
 {
 	scale_ = that->scale_;
 	gradient_ = that->gradient_;
+	if (staticSurface_) cairo_surface_destroy (staticSurface_);
+	staticSurface_ = nullptr;
+	segmentColors_.clear();
+	incremental_ = that->incremental_;
+	fullDraw_ = true;
 	ValueTransferable<double>::operator= (*that);
+	MeterFeedable::operator= (*that);
 	ValidatableRange<double>::operator= (*that);
 	ValueableTyped<double>::operator= (*that);
 	Widget::copy (that);
@@ -316,10 +473,25 @@ inline void VMeter::update ()
 		f->resize();
 	}
 
-	scale_ = BUtilities::Area<> (getXOffset(), getYOffset(), getEffectiveWidth(), getEffectiveHeight());
+	const BUtilities::Area<> scale = BUtilities::Area<> (getXOffset(), getYOffset(), getEffectiveWidth(), getEffectiveHeight());
+	if (scheduleIncrementalDraw (scale)) return;
+
+	scale_ = scale;
 	Widget::update();
 }
 
+inline void VMeter::setValue (const double& value)
+{
+	valueChanging_ = true;
+	ValueableTyped<double>::setValue (value);
+	valueChanging_ = false;
+}
+
+inline void VMeter::setValue (double&& value)
+{
+	setValue (static_cast<const double&> (value));
+}
+
 inline BStyles::ColorMap VMeter::getHiColors() const
 {
     BStyles::Style::const_iterator it = style_.find (BUtilities::Urid::urid (STYLEPROPERTY_HICOLORS_URI));
@@ -332,9 +504,200 @@ inline void VMeter::setHiColors (const BStyles::ColorMap& colors)
     style_[BUtilities::Urid::urid (STYLEPROPERTY_HICOLORS_URI)] = BUtilities::makeAny<BStyles::ColorMap> (colors);
 }
 
+inline void VMeter::publishLevel (const double level, const double hold)
+{
+	const double value = getValue();
+	const bool holdChanged = (hold != hold_);
+	hold_ = hold;
+	setValue (level);
+
+	// Value unchanged: Update the marker only
+	if (holdChanged && (getValue() == value))
+	{
+		valueChanging_ = true;
+		update ();
+		valueChanging_ = false;
+	}
+}
+
+inline double VMeter::getHoldPos () const
+{
+	const double rval = getRatioFromValue (getValue());
+	const double hval = std::max (std::min (getRatioFromValue (hold_), 1.0), 0.0);
+	if (hval <= rval) return -1.0;
+	return (step_ >= 0.0 ? hval : 1.0 - hval);
+}
+
+inline void VMeter::drawHold (cairo_t* cr, const double step, const std::vector<MeterSegmentColor>& colors)
+{
+	const double hpos = getHoldPos ();
+	if (hpos < 0.0) return;
+
+	const double hmin = (step_ >= 0.0 ? hpos - step : hpos);
+	const double hmax = (step_ >= 0.0 ? hpos : hpos + step);
+	drawVMeterActive	(cr, scale_.getX(), scale_.getY(), scale_.getWidth(), scale_.getHeight(), hmin, hmax, step, colors);
+}
+
+inline void VMeter::drawStatic (const double step, const BStyles::Color& bgColor)
+{
+	if
+	(
+		staticSurface_ &&
+		(cairo_image_surface_get_width (staticSurface_) == cairo_image_surface_get_width (surface_)) &&
+		(cairo_image_surface_get_height (staticSurface_) == cairo_image_surface_get_height (surface_)) &&
+		(staticScale_ == scale_) &&
+		(staticStep_ == step) &&
+		(staticBgColor_ == bgColor)
+	) return;
+
+	if (staticSurface_) cairo_surface_destroy (staticSurface_);
+	staticSurface_ = cairo_image_surface_create (CAIRO_FORMAT_ARGB32, getWidth(), getHeight());
+	staticScale_ = scale_;
+	staticStep_ = step;
+	staticBgColor_ = bgColor;
+
+	if (cairo_surface_status (staticSurface_) != CAIRO_STATUS_SUCCESS) return;
+	cairo_t* cr = cairo_create (staticSurface_);
+	if (cairo_status (cr) == CAIRO_STATUS_SUCCESS)
+	{
+		drawVMeterStatic (cr, scale_.getX(), scale_.getY(), scale_.getWidth(), scale_.getHeight(), step, bgColor);
+	}
+	cairo_destroy (cr);
+}
+
+inline const std::vector<MeterSegmentColor>& VMeter::getSegmentColors (const double step, const BStyles::Color& loColor, const BStyles::Color& hiColor)
+{
+	if (segmentColors_.empty() || (segmentStep_ != step) || (segmentLoColor_ != loColor) || (segmentHiColor_ != hiColor))
+	{
+		makeMeterSegmentColors (segmentColors_, step, loColor, hiColor, gradient_);
+		segmentStep_ = step;
+		segmentLoColor_ = loColor;
+		segmentHiColor_ = hiColor;
+	}
+
+	return segmentColors_;
+}
+
+inline double VMeter::getSegmentStep () const
+{
+	return (std::fabs (getStep()) > 1.0 / scale_.getHeight() ? std::fabs (getStep() / (getMax() - getMin())) : 1.0 / scale_.getHeight());
+}
+
+inline BUtilities::Area<> VMeter::getSegmentArea (const double from, const double to) const
+{
+	const double h = scale_.getHeight() - 0.2 * scale_.getWidth();
+	const double y1 = floor (scale_.getY() + scale_.getHeight() - 0.1 * scale_.getWidth() - to * h - 1.0);
+	const double y2 = ceil (scale_.getY() + scale_.getHeight() - 0.1 * scale_.getWidth() - from * h + 1.0);
+	BUtilities::Area<> a = BUtilities::Area<> (scale_.getX(), y1, scale_.getWidth(), y2 - y1);
+	a.intersect (BUtilities::Area<> (0, 0, getWidth(), getHeight()));
+	return a;
+}
+
+inline bool VMeter::scheduleIncrementalDraw (const BUtilities::Area<>& scale)
+{
+	if 
+	(
+		(!incremental_) || (!valueChanging_) || fullDraw_ || (drawnPos_ < 0.0) || 
+		(scale != scale_) || (getBgColors()[getStatus()].alpha != 1.0)
+	)
+	{
+		fullDraw_ = true;
+		return false;
+	}
+
+	const double rval = getRatioFromValue (getValue());
+	const double pos = (step_ >= 0.0 ? rval : 1.0 - rval);
+	if (damageLo_ > damageHi_)
+	{
+		damageLo_ = drawnPos_;
+		damageHi_ = drawnPos_;
+	}
+	damageLo_ = std::min (damageLo_, pos);
+	damageHi_ = std::max (damageHi_, pos);
+
+	// Old and new peak hold marker
+	const double hpos = getHoldPos ();
+	if (drawnHold_ >= 0.0)
+	{
+		damageLo_ = std::min (damageLo_, drawnHold_);
+		damageHi_ = std::max (damageHi_, drawnHold_);
+	}
+	if (hpos >= 0.0)
+	{
+		damageLo_ = std::min (damageLo_, hpos);
+		damageHi_ = std::max (damageHi_, hpos);
+	}
+	scheduleDraw_ = true;
+
+	if (isVisible ())
+	{
+		const double drv = getSegmentStep();
+		BUtilities::Area<> a = getSegmentArea (damageLo_ - drv, damageHi_ + drv);
+		a.moveTo (a.getPosition() + getAbsolutePosition());
+		emitExposeEvent (a);
+	}
+
+	return true;
+}
+
+inline void VMeter::drawIncremental ()
+{
+	scheduleDraw_ = false;
+	if ((!surface_) || (cairo_surface_status (surface_) != CAIRO_STATUS_SUCCESS)) return;
+
+	const double drv = getSegmentStep();
+	const BStyles::Color bgColor = getBgColors()[getStatus()];
+
+	// Fall back to full draw if the static elements changed
+	if
+	(
+		(!staticSurface_) || (cairo_surface_status (staticSurface_) != CAIRO_STATUS_SUCCESS) ||
+		(staticScale_ != scale_) || (staticStep_ != drv) || (staticBgColor_ != bgColor)
+	)
+	{
+		draw (0, 0, getWidth(), getHeight());
+		return;
+	}
+
+	const double rval = getRatioFromValue (getValue());
+	const double lo = damageLo_ - drv;
+	const double hi = damageHi_ + drv;
+	const BUtilities::Area<> area = getSegmentArea (lo, hi);
+	cairo_t* cr = cairo_create (surface_);
+
+	if (cairo_status (cr) == CAIRO_STATUS_SUCCESS)
+	{
+		// Restore inactive segments
+		restoreBackground (cr, area);
+		cairo_set_source_surface (cr, staticSurface_, 0, 0);
+		cairo_paint (cr);
+
+		// Draw active segments
+		const std::vector<MeterSegmentColor>& colors = getSegmentColors (drv, getFgColors()[getStatus()], getHiColors()[getStatus()]);
+		const double amin = (step_ >= 0.0 ? 0.0 : 1.0 - rval);
+		const double amax = (step_ >= 0.0 ? rval : 1.0);
+
+		// Snap to the segment grid (with half a step tolerance) to redraw
+		// segments partially inside the restored area, too
+		const double slo = std::floor (lo / drv) * drv - 0.5 * drv;
+		const double shi = std::ceil (hi / drv) * drv + 0.5 * drv;
+		drawVMeterActive	(cr, scale_.getX(), scale_.getY(), scale_.getWidth(), scale_.getHeight(), 
+							 std::max (amin, slo), std::min (amax, shi), drv, colors);
+		drawHold (cr, drv, colors);
+	}
+
+	cairo_destroy (cr);
+
+	drawnPos_ = (step_ >= 0.0 ? rval : 1.0 - rval);
+	drawnHold_ = getHoldPos ();
+	damageLo_ = 1.0;
+	damageHi_ = 0.0;
+}
+
 inline void VMeter::draw ()
 {
-	draw (0, 0, getWidth(), getHeight());
+	if ((!fullDraw_) && (damageLo_ <= damageHi_)) drawIncremental ();
+	else draw (0, 0, getWidth(), getHeight());
 }
 
 inline void VMeter::draw (const double x0, const double y0, const double width, const double height)
@@ -349,6 +712,12 @@ inline void VMeter::draw (const BUtilities::Area<>& area)
 	// Draw super class widget elements first
 	Widget::draw (area);
 
+	fullDraw_ = false;
+	drawnPos_ = -1.0;
+	drawnHold_ = -1.0;
+	damageLo_ = 1.0;
+	damageHi_ = 0.0;
+
 	// Draw only if minimum requirements satisfied
 	if ((getHeight () >= 1) && (getWidth () >= 1) && (getMin() < getMax()))
 	{
@@ -361,18 +730,34 @@ inline void VMeter::draw (const BUtilities::Area<>& area)
 			cairo_clip (cr);
 
 			const double rval = getRatioFromValue (getValue());
-			const double drv = (std::fabs (getStep()) > 1.0 / scale_.getHeight() ? std::fabs (getStep() / (getMax() - getMin())) : 1.0 / scale_.getHeight());
+			const double drv = getSegmentStep();
+
+			// Blit static elements
+			drawStatic (drv, getBgColors()[getStatus()]);
+			if (staticSurface_ && (cairo_surface_status (staticSurface_) == CAIRO_STATUS_SUCCESS))
+			{
+				cairo_set_source_surface (cr, staticSurface_, 0, 0);
+				cairo_paint (cr);
+			}
 
+			// Draw active segments
+			const std::vector<MeterSegmentColor>& colors = getSegmentColors (drv, getFgColors()[getStatus()], getHiColors()[getStatus()]);
 			if (step_ >= 0.0)
 			{
-				drawVMeter	(cr, scale_.getX(), scale_.getY(), scale_.getWidth(), scale_.getHeight(), 0.0, rval, drv,
-								 getFgColors()[getStatus()], getHiColors()[getStatus()], gradient_, getBgColors()[getStatus()]);
+				drawVMeterActive	(cr, scale_.getX(), scale_.getY(), scale_.getWidth(), scale_.getHeight(), 0.0, rval, drv, colors);
 			}
 
 			else
 			{
-				drawVMeter	(cr, scale_.getX(), scale_.getY(), scale_.getWidth(), scale_.getHeight(), 1.0 - rval, 1.0, drv,
-								 getFgColors()[getStatus()], getHiColors()[getStatus()], gradient_, getBgColors()[getStatus()]);
+				drawVMeterActive	(cr, scale_.getX(), scale_.getY(), scale_.getWidth(), scale_.getHeight(), 1.0 - rval, 1.0, drv, colors);
+			}
+			drawHold (cr, drv, colors);
+
+			// Remember the drawn value if the whole meter is drawn
+			if (area.includes (BUtilities::Area<> (0, 0, getWidth(), getHeight())))
+			{
+				drawnPos_ = (step_ >= 0.0 ? rval : 1.0 - rval);
+				drawnHold_ = getHoldPos ();
 			}
 		}
 
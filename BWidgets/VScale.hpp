@@ -212,7 +212,7 @@ inline VScale::VScale	(const double  x, const double y, const double width, cons
 		Draggable(),
 		Scrollable()
 {
-
+	incremental_ = false;	// Own draw methods
 }
 
 inline Widget* VScale::clone () const 
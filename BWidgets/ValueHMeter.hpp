@@ -275,13 +275,16 @@ inline void ValueHMeter::update ()
 	label.resize ();
 	label.moveTo (getXOffset() + getEffectiveWidth() - 2.0 * getEffectiveHeight(), label.middle());
 
-	scale_ = BUtilities::Area<> 
+	const BUtilities::Area<> scale = BUtilities::Area<> 
 	(
 		getXOffset(), 
 		getYOffset(), 
 		getEffectiveWidth() - 2.5 * getEffectiveHeight(),
 		getEffectiveHeight()
 	);
+	if (scheduleIncrementalDraw (scale)) return;
+
+	scale_ = scale;
 
 	Widget::update();
 }
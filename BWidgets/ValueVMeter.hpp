@@ -253,13 +253,16 @@ inline void ValueVMeter::update ()
 	label.resize();
 	label.moveTo (label.center(), getYOffset());
 
-	scale_ = BUtilities::Area<> 
+	const BUtilities::Area<> scale = BUtilities::Area<> 
 	(
 		getXOffset() + 0.25 * getEffectiveWidth(), 
 		getYOffset() + label.getHeight(), 
 		0.5 * getEffectiveWidth(),
 		getEffectiveHeight() - label.getHeight()
 	);
+	if (scheduleIncrementalDraw (scale)) return;
+
+	scale_ = scale;
 
 	Widget::update();
 }
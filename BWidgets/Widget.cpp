@@ -50,7 +50,9 @@ Widget::Widget (const double x, const double y, const double width, const double
 	title_ (title),
 	style_ (),
 	focus_ (title == "" ? nullptr : new (std::nothrow) Label (title, BUtilities::Urid::urid (BUtilities::Urid::uri (urid) + "/focus"), "")),
-	pushStyle_ (true)
+	pushStyle_ (true),
+	escapeArea_ (),
+	escapeAreaValid_ (false)
 {
 	if (focus_) 
 	{
@@ -96,6 +98,8 @@ void Widget::copy (const Widget* that)
 	focus_ = (that->focus_ ? that->focus_->clone() : nullptr);
 
 	pushStyle_ = that->pushStyle_;
+	invalidateFamilyArea ();
+	if (getParentWidget()) getParentWidget()->invalidateFamilyArea ();
 	
 	update();
 }
@@ -151,19 +155,21 @@ std::string Widget::getTitle () const
 	return title_;
 }
 
-std::list<Linkable*>::iterator Widget::add (Linkable* child, std::function<void (Linkable* obj)> addfunc)
+std::vector<Linkable*>::iterator Widget::add (Linkable* child, std::function<void (Linkable* obj)> addfunc)
 {
 	// Only accept Widgets
 	Widget* childWidget = dynamic_cast<Widget*> (child);
 	if (!childWidget) return children_.end();
 
-	std::list<Linkable*>::iterator it = Linkable::add 
+	invalidateFamilyArea ();
+	std::vector<Linkable*>::iterator it = Linkable::add 
 	(
 		child,
 		[addfunc] (Linkable* l)
 		{
 			Widget* w = dynamic_cast<Widget*>(l);
 			addfunc (l);
+			if (w && w->getMainWindow()) w->getMainWindow()->addPollable (w);
 			if (w) w->update ();
 
 			// TODO Stacking
@@ -198,6 +204,7 @@ void Widget::release (Linkable* child, std::function<void (Linkable* obj)> relea
 
 	bool wasVisible = childWidget->isVisible ();
 	childWidget->hide();
+	invalidateFamilyArea ();
 	Linkable::release
 	(
 		child,
@@ -209,6 +216,7 @@ void Widget::release (Linkable* child, std::function<void (Linkable* obj)> relea
 				w->getMainWindow()->purgeEventQueue (w);
 				w->getMainWindow()->getButtonGrabStack()->remove (w);
 				w->getMainWindow()->getKeyGrabStack()->remove (w);
+				w->getMainWindow()->removePollable (w);
 				w->main_ = nullptr;
 				releasefunc (l);
 			}
@@ -226,37 +234,21 @@ void Widget::release (Linkable* child, std::function<void (Linkable* obj)> relea
 void Widget::raise ()
 {
 	if (!parent_) return;
-	if (getParent()->getChildren().size() < 2) return;
+	if (childIndex_ + 1 >= getParent()->getChildren().size()) return;
 
-	std::list<Linkable*>::iterator lit = std::prev(getParent()->getChildren().end(), 2);
-	for	(std::list<Linkable*>::iterator it = getParent()->getChildren().begin(); it != lit; ++it)
-	{
-		if (*it == this)
-		{
-			std::swap (*it, *(std::next (it)));
-			Widget* parentWidget = getParentWidget();
-			if (parentWidget && parentWidget->isVisible ()) parentWidget->emitExposeEvent ();
-			break;
-		}
-	}
+	getParent()->moveChild (this, childIndex_ + 1);
+	Widget* parentWidget = getParentWidget();
+	if (parentWidget && parentWidget->isVisible ()) parentWidget->emitExposeEvent ();
 }
 
 void Widget::drop ()
 {
 	if (!parent_) return;
-	if (getParent()->getChildren().size() < 2) return;
+	if (childIndex_ == 0) return;
 
-	std::list<Linkable*>::iterator lit = std::prev(getParent()->getChildren().end());
-	for	(std::list<Linkable*>::iterator it = std::next (getParent()->getChildren().begin()); it != lit; ++it)
-	{
-		if (*it == this)
-		{
-			std::swap (*it, *(std::prev (it)));
-			Widget* parentWidget = getParentWidget();
-			if (parentWidget && parentWidget->isVisible ()) parentWidget->emitExposeEvent ();
-			break;
-		}
-	}
+	getParent()->moveChild (this, childIndex_ - 1);
+	Widget* parentWidget = getParentWidget();
+	if (parentWidget && parentWidget->isVisible ()) parentWidget->emitExposeEvent ();
 }
 
 void Widget::dropToBack ()
@@ -264,14 +256,9 @@ void Widget::dropToBack ()
 	if (!parent_) return;
 	if (getParent()->getChildren().size() < 2) return;
 
-	std::list<Linkable*>::iterator it = std::find (getParent()->getChildren().begin(), getParent()->getChildren().end(), this);
-	if (it != getParent()->getChildren().end())
-	{
-		getParent()->getChildren().erase (it);
-		getParent()->getChildren().push_front (this);
-		Widget* parentWidget = getParentWidget();
-		if (parentWidget && parentWidget->isVisible ()) parentWidget->emitExposeEvent ();
-	}
+	getParent()->moveChild (this, 0);
+	Widget* parentWidget = getParentWidget();
+	if (parentWidget && parentWidget->isVisible ()) parentWidget->emitExposeEvent ();
 }
 
 void Widget::raiseToFront ()
@@ -279,14 +266,9 @@ void Widget::raiseToFront ()
 	if (!parent_) return;
 	if (getParent()->getChildren().size() < 2) return;
 
-	std::list<Linkable*>::iterator it = std::find (getParent()->getChildren().begin(), getParent()->getChildren().end(), this);
-	if (it != getParent()->getChildren().end())
-	{
-		getParent()->getChildren().erase (it);
-		getParent()->getChildren().push_back (this);
-		Widget* parentWidget = getParentWidget();
-		if (parentWidget && parentWidget->isVisible ()) parentWidget->emitExposeEvent ();
-	}
+	getParent()->moveChild (this, getParent()->getChildren().size() - 1);
+	Widget* parentWidget = getParentWidget();
+	if (parentWidget && parentWidget->isVisible ()) parentWidget->emitExposeEvent ();
 }
 
 Window* Widget::getMainWindow () const 
@@ -301,6 +283,7 @@ void Widget::show()
 	if (isVisualizable()) return;
 
 	Visualizable::setSupport (true);
+	if (getParentWidget()) getParentWidget()->invalidateFamilyArea ();
 
 	if (isVisible ())
 	{
@@ -322,8 +305,10 @@ void Widget::hide()
 	bool wasVisible = isVisible ();
 
 	// Get area occupied by this widget and its children
-	BUtilities::Area<> hideArea = getAbsoluteFamilyArea ([] (const Widget* w) {return w->isVisible();});
+	BUtilities::Area<> hideArea = getVisibleFamilyArea ();
+	hideArea.moveTo (hideArea.getPosition() + getAbsolutePosition());
 	Visualizable::setSupport (false);
+	if (getParentWidget()) getParentWidget()->invalidateFamilyArea ();
 
 	if (wasVisible && (this != dynamic_cast<Widget*> (getMainWindow())))
 	{
@@ -378,6 +363,7 @@ void Widget::resize (const double width, const double height)
 
 void Widget::resize (const BUtilities::Point<> extends)
 {
+	if (getParentWidget() && ((extends.x != extends_.x) || (extends.y != extends_.y))) getParentWidget()->invalidateFamilyArea ();
 	Visualizable::resize (extends);
 }
 
@@ -388,6 +374,7 @@ void Widget::moveTo (const BUtilities::Point<>& position)
 	if ((position_.x != position.x) || (position_.y != position.y))
 	{
 		position_ = position;
+		if (getParentWidget()) getParentWidget()->invalidateFamilyArea ();
 		if (isVisible () && getParentWidget()) getParentWidget()->emitExposeEvent ();
 	}
 }
@@ -501,7 +488,9 @@ BStyles::Status Widget::getStatus () const
 
 void Widget::setStacking (const Widget::Stacking stacking) 
 {
+	if (stacking == stacking_) return;
 	stacking_ = stacking;
+	if (getParentWidget()) getParentWidget()->invalidateFamilyArea ();
 }
 
 Widget::Stacking Widget::getStacking () const 
@@ -621,10 +610,34 @@ void Widget::setTxColors (const BStyles::ColorMap& colors)
 	}
 }
 
+void Widget::restoreBackground (cairo_t* cr, const BUtilities::Area<>& area) const
+{
+	const BStyles::Border border = getBorder();
+	const double innerBorders = getXOffset ();
+	const double innerRadius = (border.radius > border.padding ? border.radius - border.padding : 0);
+
+	BUtilities::Area<> a = area;
+	a.intersect (BUtilities::Area<> (innerBorders, innerBorders, getEffectiveWidth (), getEffectiveHeight ()));
+	cairo_rectangle (cr, a.getX (), a.getY (), a.getWidth (), a.getHeight ());
+	cairo_clip (cr);
+
+	cairo_set_operator (cr, CAIRO_OPERATOR_CLEAR);
+	cairo_paint (cr);
+	cairo_set_operator (cr, CAIRO_OPERATOR_OVER);
+
+	if ((getEffectiveWidth () > 0) && (getEffectiveHeight () > 0))
+	{
+		BStyles::Fill background = getBackground();
+		background.setCairoSource (cr);
+		cairoplus_rectangle_rounded (cr, innerBorders, innerBorders, getEffectiveWidth (), getEffectiveHeight (), innerRadius, 0b1111);
+		cairo_fill (cr);
+	}
+}
+
 void Widget::emitExposeEvent ()
 {
-	BUtilities::Area<> area = getFamilyArea ([] (const Widget* w) {return w->isVisible();});
-	area.moveTo (getAbsolutePosition ());
+	BUtilities::Area<> area = getVisibleFamilyArea ();
+	area.moveTo (area.getPosition() + getAbsolutePosition ());
 	emitExposeEvent (area);
 }
 
@@ -663,81 +676,73 @@ void Widget::onFocusOut (BEvents::Event* event)
 	PointerFocusable::onFocusOut (event);
 }
 
-Widget* Widget::getWidgetAt	(const BUtilities::Point<>& position, 
-							 std::function<bool (Widget* widget)> func,
-							 std::function<bool (Widget* widget)> passfunc)
+Widget* Widget::getWidgetAt	(const BUtilities::Point<>& position)
 {
-	BUtilities::Area<> absarea = getAbsoluteArea ();
-	return getWidgetAt (getAbsolutePosition () + position, absarea, absarea, func, passfunc);
+	return getWidgetAt (position, [] (Widget* widget) {return true;}, [] (Widget* widget) {return true;});
 }
 
-Widget* Widget::getWidgetAt	(const BUtilities::Point<>& abspos, 
-							 const BUtilities::Area<>& outerArea,
-			    			 const BUtilities::Area<>& area, 
-							 std::function<bool (Widget* widget)> func,
-							 std::function<bool (Widget* widget)> passfunc)
+Widget* Widget::getMainWindowWidget () const
 {
-	BUtilities::Area<> a = (getStacking() == STACKING_ESCAPE ? outerArea : area);
-	BUtilities::Area<> thisArea = getArea();
-	thisArea.moveTo (getAbsolutePosition());
-	thisArea.intersect (a);
-	if (getMainWindow())
-	{
-		Widget* finalw =
-		(
-			((thisArea != BUtilities::Area<> ()) && thisArea.contains (abspos)) ? 
-			(
-				func (this) ?
-				this : 
-				(
-					passfunc (this) ?
-					nullptr :
-					getMainWindow() // "Sink" to block passing events
-				)
-			) :
-			nullptr);
-
-		for (Linkable* l : children_)
-		{
-			Widget* w = dynamic_cast<Widget*> (l);
-			if (w)
-			{
-				Widget* nextw = w->getWidgetAt (abspos, outerArea, thisArea, func, passfunc);
-				if (nextw) finalw = nextw;
-			}
-		}
-		return finalw;
-	}
+	return getMainWindow();
+}
+
+BUtilities::Area<> Widget::getFamilyArea () const
+{
+	return getFamilyArea ([] (const Widget* widget) {return true;});
+}
 
-	else return nullptr;
+BUtilities::Area<> Widget::getAbsoluteFamilyArea () const
+{
+	return getAbsoluteFamilyArea ([] (const Widget* widget) {return true;});
 }
 
-BUtilities::Area<> Widget::getFamilyArea (std::function<bool (const Widget* widget)> func) const
+BUtilities::Area<> Widget::getVisibleFamilyArea () const
 {
-	BUtilities::Area<> a = getAbsoluteFamilyArea (func);
-	a.moveTo (a.getPosition() - getAbsolutePosition());
+	BUtilities::Area<> a = BUtilities::Area<> (BUtilities::Point<> (0, 0), extends_);
+	if (isVisible())
+	{
+		const BUtilities::Area<>& e = getEscapeArea ();
+		if (e != BUtilities::Area<> ()) a.extend (e);
+	}
 	return a;
 }
 
-BUtilities::Area<> Widget::getAbsoluteFamilyArea (std::function<bool (const Widget* widget)> func) const
+const BUtilities::Area<>& Widget::getEscapeArea () const
 {
-	BUtilities::Area<> a = getAbsoluteArea();
-	forEachChild 
-	(
-		[&a, func] (Linkable* l)
+	// Validation from bottom to top. Thus, valid widgets only have valid
+	// visualizable children.
+	if (!escapeAreaValid_)
+	{
+		BUtilities::Area<> e = BUtilities::Area<> ();
+		for (const Linkable* l : children_)
 		{
-			Widget* w = dynamic_cast<Widget*> (l);
-			if (w)
+			const Widget* w = dynamic_cast<const Widget*> (l);
+			if ((!w) || (!w->isVisualizable())) continue;
+
+			// Escaping children and their escaping descendants
+			BUtilities::Area<> c = w->getEscapeArea ();
+			if (c != BUtilities::Area<> ()) c.moveTo (c.getPosition() + w->getPosition());
+			if (w->getStacking() == STACKING_ESCAPE)
 			{
-				bool check = func (w);
-				if (check && (w->getStacking() == STACKING_ESCAPE )) a.extend (w->getAbsoluteArea());
-				return check;
+				if (c == BUtilities::Area<> ()) c = w->getArea();
+				else c.extend (w->getArea());
 			}
-			return false;
+
+			if (c == BUtilities::Area<> ()) continue;
+			if (e == BUtilities::Area<> ()) e = c;
+			else e.extend (c);
 		}
-	);
 
-	return a;
+		escapeArea_ = e;
+		escapeAreaValid_ = true;
+	}
+
+	return escapeArea_;
+}
+
+void Widget::invalidateFamilyArea ()
+{
+	for (Widget* w = this; w && w->escapeAreaValid_; w = w->getParentWidget()) w->escapeAreaValid_ = false;
 }
 
 void Widget::display (std::map<int, cairo_surface_t*>& surfaces, const BUtilities::Point<> surfaceExtends, const BUtilities::Area<>& area)
@@ -778,9 +783,9 @@ void Widget::display (std::map<int, cairo_surface_t*>& surfaces, const BUtilitie
 			cairo_destroy (cr);
 		}
 
-		for (Linkable* l : children_)
+		for (size_t i = 0; i < children_.size(); ++i)
 		{
-			Widget* w = dynamic_cast<Widget*> (l);
+			Widget* w = dynamic_cast<Widget*> (children_[i]);
 			if (w) w->display (surfaces, surfaceExtends, outerArea, a);
 		}
 	}
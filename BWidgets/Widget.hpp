@@ -120,6 +120,8 @@ protected:
 	BStyles::Style style_;
 	Widget* focus_;
 	bool pushStyle_;
+	mutable BUtilities::Area<> escapeArea_;		// Cached area of visible escaping descendants, relative to this widget
+	mutable bool escapeAreaValid_;
 
 public:
 
@@ -199,7 +201,8 @@ public:
 	 *  @param child  Child widget.
 	 *  @param addfunc  Optional, function to be executed once a child object
 	 *  is added.
-	 *  @return  Iterator for the inserted child.
+	 *  @return  Iterator for the inserted child. Invalidated by the next
+	 *  change of the children.
 	 *
 	 *  New child objects are appended to the end of list of children objects
 	 *  (see @c getChildren() ).
@@ -207,7 +210,7 @@ public:
 	 *  Returns @c getChildren().end() if noting inserted (e.g, trying to add
 	 *  a @c nullptr or linking is switched off).
 	 */
-	virtual std::list<Linkable*>::iterator 
+	virtual std::vector<Linkable*>::iterator 
 	add	(Linkable* child, std::function<void (Linkable* obj)> addfunc = [] (Linkable* obj) {}) 
 	override;
 
@@ -685,28 +688,79 @@ protected:
 
 	/**
 	 *  @brief  Gets the area covered by this %Widget and all its children.
-	 *  @param func  Optional, filter function.
 	 */
-	BUtilities::Area<> getFamilyArea (std::function<bool (const Widget* widget)> func = [] (const Widget* widget) {return true;}) const;
+	BUtilities::Area<> getFamilyArea () const;
+
+	/**
+	 *  @brief  Gets the area covered by this %Widget and all its children.
+	 *  @tparam F  Callable type bool (const Widget* widget).
+	 *  @param func  Filter function.
+	 */
+	template <class F>
+	BUtilities::Area<> getFamilyArea (F func) const;
 
 	/**
 	 *  @brief  Gets the area covered by this %Widget and all its children
 	 *  relative to the root widget (e. g., the main Window).
-	 *  @param func  Optional, filter function.
 	 */
-	BUtilities::Area<> getAbsoluteFamilyArea (std::function<bool (const Widget* widget)> func = [] (const Widget* widget) {return true;}) const;
+	BUtilities::Area<> getAbsoluteFamilyArea () const;
+
+	/**
+	 *  @brief  Gets the area covered by this %Widget and all its children
+	 *  relative to the root widget (e. g., the main Window).
+	 *  @tparam F  Callable type bool (const Widget* widget).
+	 *  @param func  Filter function.
+	 */
+	template <class F>
+	BUtilities::Area<> getAbsoluteFamilyArea (F func) const;
+
+	/**
+	 *  @brief  Gets the area covered by this %Widget and all its visible 
+	 *  children.
+	 *  @return  Area relative to this %Widget.
+	 *
+	 *  Same as @c getFamilyArea() filtered by @c isVisible() . But the area
+	 *  of the escaping children is cached and only recalculated after 
+	 *  changes of the geometry, the stacking, or the visibility of the 
+	 *  children (see @c invalidateFamilyArea() ).
+	 */
+	BUtilities::Area<> getVisibleFamilyArea () const;
+
+	/**
+	 *  @brief  Invalidates the cached family areas of this %Widget and of 
+	 *  all its parents.
+	 */
+	void invalidateFamilyArea ();
+
+	/**
+	 *  @brief  Gets the top %Widget at a given position.
+	 *  @param position  Position. 
+	 *  @return  Pointer to the %Widget. 
+	 */
+	Widget* getWidgetAt	(const BUtilities::Point<>& position);
+
+	/**
+	 *  @brief  Gets the top %Widget at a given position.
+	 *  @tparam F  Callable type bool (Widget* widget).
+	 *  @param position  Position. 
+	 *  @param func  Filter function.
+	 *  @return  Pointer to the %Widget. 
+	 */
+	template <class F>
+	Widget* getWidgetAt	(const BUtilities::Point<>& position, F func);
 
 	/**
 	 *  @brief  Gets the top %Widget at a given position.
+	 *  @tparam F  Callable type bool (Widget* widget).
+	 *  @tparam P  Callable type bool (Widget* widget).
 	 *  @param position  Position. 
-	 *  @param func  Optional, filter function.
-	 *  @param passfunc  Optional, function to check whether to check the next
-	 *  lower level result if @a func returned false.
+	 *  @param func  Filter function.
+	 *  @param passfunc  Function to check whether to check the next lower
+	 *  level result if @a func returned false.
 	 *  @return  Pointer to the %Widget. 
 	 */
-	Widget* getWidgetAt	(const BUtilities::Point<>& position, 
-						 std::function<bool (Widget* widget)> func = [] (Widget* widget) {return true;},
-						 std::function<bool (Widget* widget)> passfunc = [] (Widget* widget) {return true;});
+	template <class F, class P>
+	Widget* getWidgetAt	(const BUtilities::Point<>& position, F func, P passfunc);
 
 	/**
 	 *  @brief  Draws %Widget surface and children surfaces to the provided
@@ -744,16 +798,121 @@ protected:
      */
     virtual void draw (const BUtilities::Area<>& area) override;
 
+	/**
+	 *  @brief  Restores the background of a part of the %Widget surface.
+	 *  @param cr  Cairo context of the %Widget surface.
+	 *  @param area  Area to be restored.
+	 *
+	 *  Clips @a cr to @a area within the inner borders, clears it, and 
+	 *  fills it with the background. Intended for incremental draws of parts
+	 *  of a widget. The clip remains active to redraw the content of the
+	 *  area. As the clip may cut parts of neighboring elements, all 
+	 *  elements within @a area have to be redrawn. Use @c cairo_save() and
+	 *  @c cairo_restore() to reset the clip.
+	 */
+	void restoreBackground (cairo_t* cr, const BUtilities::Area<>& area) const;
+
 private:
 	void display (std::map<int, cairo_surface_t*>& surfaces, const BUtilities::Point<> surfaceExtends, const BUtilities::Area<>& outerArea, const BUtilities::Area<>& area);
 
+	template <class F, class P>
 	Widget* getWidgetAt	(const BUtilities::Point<>& abspos, 
 						 const BUtilities::Area<>& outerArea,
 			   			 const BUtilities::Area<>& area, 
-						 std::function<bool (Widget* widget)> func = [] (Widget* widget) {return true;},
-						 std::function<bool (Widget* widget)> passfunc = [] (Widget* widget) {return true;});
+						 F& func,
+						 P& passfunc);
+
+	Widget* getMainWindowWidget () const;
+
+	const BUtilities::Area<>& getEscapeArea () const;
 };
 
+template <class F>
+inline BUtilities::Area<> Widget::getFamilyArea (F func) const
+{
+	BUtilities::Area<> a = getAbsoluteFamilyArea (func);
+	a.moveTo (a.getPosition() - getAbsolutePosition());
+	return a;
+}
+
+template <class F>
+inline BUtilities::Area<> Widget::getAbsoluteFamilyArea (F func) const
+{
+	BUtilities::Area<> a = getAbsoluteArea();
+	forEachChild 
+	(
+		[&a, &func] (Linkable* l)
+		{
+			Widget* w = dynamic_cast<Widget*> (l);
+			if (w)
+			{
+				bool check = func (w);
+				if (check && (w->getStacking() == STACKING_ESCAPE )) a.extend (w->getAbsoluteArea());
+				return check;
+			}
+			return false;
+		}
+	);
+
+	return a;
+}
+
+template <class F>
+inline Widget* Widget::getWidgetAt (const BUtilities::Point<>& position, F func)
+{
+	return getWidgetAt (position, func, [] (Widget* widget) {return true;});
+}
+
+template <class F, class P>
+inline Widget* Widget::getWidgetAt (const BUtilities::Point<>& position, F func, P passfunc)
+{
+	BUtilities::Area<> absarea = getAbsoluteArea ();
+	return getWidgetAt (getAbsolutePosition () + position, absarea, absarea, func, passfunc);
+}
+
+template <class F, class P>
+inline Widget* Widget::getWidgetAt	(const BUtilities::Point<>& abspos, 
+									 const BUtilities::Area<>& outerArea,
+									 const BUtilities::Area<>& area, 
+									 F& func,
+									 P& passfunc)
+{
+	BUtilities::Area<> a = (getStacking() == STACKING_ESCAPE ? outerArea : area);
+	BUtilities::Area<> thisArea = getArea();
+	thisArea.moveTo (getAbsolutePosition());
+	thisArea.intersect (a);
+	Widget* mainw = getMainWindowWidget();
+	if (mainw)
+	{
+		Widget* finalw =
+		(
+			((thisArea != BUtilities::Area<> ()) && thisArea.contains (abspos)) ? 
+			(
+				func (this) ?
+				this : 
+				(
+					passfunc (this) ?
+					nullptr :
+					mainw // "Sink" to block passing events
+				)
+			) :
+			nullptr);
+
+		for (size_t i = 0; i < children_.size(); ++i)
+		{
+			Widget* w = dynamic_cast<Widget*> (children_[i]);
+			if (w)
+			{
+				Widget* nextw = w->getWidgetAt (abspos, outerArea, thisArea, func, passfunc);
+				if (nextw) finalw = nextw;
+			}
+		}
+		return finalw;
+	}
+
+	else return nullptr;
+}
+
 }
 
 #endif /* BWIDGETS_WIDGET_HPP_ */
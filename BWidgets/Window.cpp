@@ -38,6 +38,7 @@
 #include "Supports/Pointable.hpp"
 #include "Supports/Scrollable.hpp"
 #include "Supports/Valueable.hpp"
+#include "Supports/Pollable.hpp"
 
 
 namespace BWidgets
@@ -62,7 +63,12 @@ Window::Window (const double width, const double height, PuglNativeView nativeWi
 		quit_ (false), 
 		focused_ (false), 
 		pointer_ (),
-		eventQueue_ ()
+		eventQueue_ (),
+		maxFps_ (BWIDGETS_DEFAULT_WINDOW_MAX_FPS),
+		damage_ (),
+		frameTime_ (std::chrono::steady_clock::now()),
+		pollables_ (),
+		pollNext_ (0)
 {
 	main_ = this;
 	layer_ = BWIDGETS_DEFAULT_WINDOW_LAYER;
@@ -91,7 +97,7 @@ Window::~Window ()
 	hide();
 	while (!children_.empty ())
 	{
-		Widget* w = dynamic_cast<Widget*>(children_.front ());
+		Widget* w = dynamic_cast<Widget*>(children_.back ());
 		if (w) release (w);
 	}
 	purgeEventQueue ();
@@ -128,6 +134,16 @@ double Window::getZoom () const
 	return zoom_;
 }
 
+void Window::setMaxFps (const double fps)
+{
+	maxFps_ = (fps > 0.0 ? fps : 0.0);
+}
+
+double Window::getMaxFps () const
+{
+	return maxFps_;
+}
+
 PuglView* Window::getPuglView () {return view_;}
 
 cairo_t* Window::getPuglContext ()
@@ -159,10 +175,12 @@ void Window::onCloseRequest (BEvents::Event* event)
 void Window::onExposeRequest (BEvents::Event* event)
 {
 	BEvents::ExposeEvent* ev = dynamic_cast<BEvents::ExposeEvent*>(event);
-	if (ev) puglPostRedisplayRect (view_,	{ev->getArea().getX() * getZoom(), 
-											 ev->getArea().getY() * getZoom(), 
-											 ev->getArea().getWidth() * getZoom(), 
-											 ev->getArea().getHeight() * getZoom()});
+	if (ev && (ev->getArea() != BUtilities::Area<>()))
+	{
+		// Collect damage until the next frame
+		if (damage_ == BUtilities::Area<>()) damage_ = ev->getArea();
+		else damage_.extend (ev->getArea());
+	}
 }
 
 void Window::addEventToQueue (BEvents::Event* event)
@@ -303,6 +321,9 @@ void Window::handleEvents ()
 	puglUpdate (world_, 0);
 	translateTimeEvent ();
 
+	const bool frameDue = isFrameDue ();
+	if (frameDue) translatePolls ();
+
 	while (!eventQueue_.empty ())
 	{
 		BEvents::Event* event = eventQueue_.front ();
@@ -456,6 +477,27 @@ void Window::handleEvents ()
 			delete event;
 		}
 	}
+
+	if (frameDue) postDamage ();
+}
+
+bool Window::isFrameDue () const
+{
+	if (maxFps_ <= 0.0) return true;
+	const std::chrono::duration<double> frameDuration = std::chrono::steady_clock::now() - frameTime_;
+	return (frameDuration.count() >= 1.0 / maxFps_);
+}
+
+void Window::postDamage ()
+{
+	if (damage_ == BUtilities::Area<>()) return;
+
+	puglPostRedisplayRect (view_,	{damage_.getX() * getZoom(), 
+									 damage_.getY() * getZoom(), 
+									 damage_.getWidth() * getZoom(), 
+									 damage_.getHeight() * getZoom()});
+	damage_ = BUtilities::Area<>();
+	frameTime_ = std::chrono::steady_clock::now();
 }
 
 PuglStatus Window::translatePuglEvent (PuglView* view, const PuglEvent* puglEvent)
@@ -543,8 +585,8 @@ PuglStatus Window::translatePuglEvent (PuglView* view, const PuglEvent* puglEven
 				Widget* widget = grab->getWidget();
 				if (widget)
 				{
-					std::set<BDevices::MouseDevice> buttonDevices = grab->getDevices();
-					std::set<BDevices::MouseDevice>::iterator it = buttonDevices.find(mouse);
+					const std::set<BDevices::MouseDevice>& buttonDevices = grab->getDevices();
+					std::set<BDevices::MouseDevice>::const_iterator it = buttonDevices.find(mouse);
 					BUtilities::Point<> origin = (it != buttonDevices.end() ? it->position : BUtilities::Point<> ());
 
 					w->addEventToQueue
@@ -605,8 +647,8 @@ PuglStatus Window::translatePuglEvent (PuglView* view, const PuglEvent* puglEven
 
 					if (widget && widget->is<Draggable>())
 					{
-						std::set<BDevices::MouseDevice> buttonDevices = grab->getDevices();
-						std::set<BDevices::MouseDevice>::iterator it = buttonDevices.find(mouse);
+						const std::set<BDevices::MouseDevice>& buttonDevices = grab->getDevices();
+						std::set<BDevices::MouseDevice>::const_iterator it = buttonDevices.find(mouse);
 						BUtilities::Point<> origin = (it != buttonDevices.end() ? it->position : BUtilities::Point<> ());
 
 						// new
@@ -777,6 +819,18 @@ PuglStatus Window::translatePuglEvent (PuglView* view, const PuglEvent* puglEven
 	return PUGL_SUCCESS;
 }
 
+void Window::translatePolls ()
+{
+	// Index-based: poll() may link or release widgets. removePollable()
+	// adjusts pollNext_ if an already polled entry is removed.
+	for (pollNext_ = 0; pollNext_ < pollables_.size(); )
+	{
+		Pollable* p = pollables_[pollNext_].second;
+		++pollNext_;
+		if (p->isPollable ()) p->poll ();
+	}
+}
+
 void Window::translateTimeEvent ()
 {
 	BDevices::MouseDevice mouse = BDevices::MouseDevice (BDevices::MouseDevice::NO_BUTTON);
@@ -789,8 +843,8 @@ void Window::translateTimeEvent ()
 			PointerFocusable* focus = dynamic_cast<PointerFocusable*> (widget);
 			if (focus)
 			{
-				std::set<BDevices::MouseDevice> buttonDevices = grab->getDevices();
-				std::set<BDevices::MouseDevice>::iterator it = buttonDevices.find(mouse);
+				const std::set<BDevices::MouseDevice>& buttonDevices = grab->getDevices();
+				std::set<BDevices::MouseDevice>::const_iterator it = buttonDevices.find(mouse);
 				BUtilities::Point<> position = (it != buttonDevices.end() ? it->position : BUtilities::Point<> ());
 				std::chrono::steady_clock::time_point nowTime = std::chrono::steady_clock::now();
 				std::chrono::steady_clock::time_point pointerTime = (it != buttonDevices.end() ? it->getTime() : nowTime);
@@ -829,8 +883,8 @@ void Window::unfocus ()
 				PointerFocusable* focus = dynamic_cast<PointerFocusable*> (widget);
 				if (focus)
 				{
-					std::set<BDevices::MouseDevice> buttonDevices = grab->getDevices();
-					std::set<BDevices::MouseDevice>::iterator it = buttonDevices.find(mouse);
+					const std::set<BDevices::MouseDevice>& buttonDevices = grab->getDevices();
+					std::set<BDevices::MouseDevice>::const_iterator it = buttonDevices.find(mouse);
 					BUtilities::Point<> position = (it != buttonDevices.end() ? it->position : BUtilities::Point<> ());
 					addEventToQueue (new BEvents::PointerFocusEvent (widget, BEvents::Event::POINTER_FOCUS_OUT_EVENT, position));
 				}
@@ -840,6 +894,32 @@ void Window::unfocus ()
 	}
 }
 
+void Window::addPollable (Widget* widget)
+{
+	Pollable* p = dynamic_cast<Pollable*> (widget);
+	if (!p) return;
+
+	for (const std::pair<Widget*, Pollable*>& wp : pollables_)
+	{
+		if (wp.first == widget) return;
+	}
+	pollables_.push_back (std::make_pair (widget, p));
+}
+
+void Window::removePollable (Widget* widget)
+{
+	// Compare widgets: Pollable can't be cast anymore upon destruction
+	for (std::vector<std::pair<Widget*, Pollable*>>::iterator it = pollables_.begin(); it != pollables_.end(); ++it)
+	{
+		if (it->first == widget)
+		{
+			if (size_t (it - pollables_.begin()) < pollNext_) --pollNext_;
+			pollables_.erase (it);
+			return;
+		}
+	}
+}
+
 void Window::purgeEventQueue (Widget* widget)
 {
 	for (std::list<BEvents::Event*>::iterator it = eventQueue_.begin (); it != eventQueue_.end (); /* empty */)
@@ -22,10 +22,14 @@
 #define BWIDGETS_DEFAULT_WINDOW_BACKGROUND BStyles::blackFill
 
 #include <chrono>
+#include <list>
+#include <utility>
+#include <vector>
 #include "Widget.hpp"
 #include "pugl/pugl/pugl.h"
 #include "../BDevices/BDevices.hpp"
 #include "Supports/Closeable.hpp"
+#include "Supports/Pollable.hpp"
 
 #ifndef BWIDGETS_DEFAULT_WINDOW_WIDTH
 #define BWIDGETS_DEFAULT_WINDOW_WIDTH 600
@@ -35,6 +39,10 @@
 #define BWIDGETS_DEFAULT_WINDOW_HEIGHT 400
 #endif
 
+#ifndef BWIDGETS_DEFAULT_WINDOW_MAX_FPS
+#define BWIDGETS_DEFAULT_WINDOW_MAX_FPS 60.0
+#endif
+
 namespace BWidgets
 {
 
@@ -76,6 +84,11 @@ protected:
 	bool focused_;
 	BUtilities::Point<> pointer_;
 	std::list<BEvents::Event*> eventQueue_;
+	double maxFps_;
+	BUtilities::Area<> damage_;
+	std::chrono::steady_clock::time_point frameTime_;
+	std::vector<std::pair<Widget*, Pollable*>> pollables_;
+	size_t pollNext_;		// Next pollable index in translatePolls()
 
 public:
 
@@ -121,6 +134,22 @@ public:
 	 */
 	double getZoom () const;
 
+	/**
+	 *  @brief  Sets the maximum frame rate.
+	 *  @param fps  Maximum number of frames per second. 0.0 for no limit.
+	 *
+	 *  Expose requests are collected and the damaged area is sent to the
+	 *  host system at most once per frame. Widget surfaces are only redrawn
+	 *  upon the (single) following host-provided expose event.
+	 */
+	void setMaxFps (const double fps);
+
+	/**
+	 *  @brief  Gets the maximum frame rate.
+	 *  @return  Maximum number of frames per second. 0.0 for no limit.
+	 */
+	double getMaxFps () const;
+
 	/**
 	 *  @brief  Get in contact to the host system via Pugl.
 	 *  @return  Pointer to the PuglView.
@@ -159,7 +188,9 @@ public:
 	 *  @brief  Main Event handler. 
 	 *
 	 *  Iterates through the event queue, analyzes the events, and and routes
-	 *  them to their respective @c onXXX() handling methods.
+	 *  them to their respective @c onXXX() handling methods. Finally requests
+	 *  a host-provided expose event for the area damaged since the last 
+	 *  frame if the next frame is due (see @c setMaxFps() ).
 	 */
 	void handleEvents ();
 
@@ -169,10 +200,12 @@ public:
 	 *  @param event  Expose request event containing the Widget that emitted
 	 *  the event and the area that should be exposed.
 	 *
-	 *  This method calls the host system to emit a host-provided expose event
-	 *  which is then interpreted in the @c translatePuglEvent() method where
-	 *  it calls drawing of all linked child widget RGBA surfaces to the host
-	 *  provided RGBA surface.
+	 *  This method adds the area to the damaged area of the current frame.
+	 *  Once per frame, @c handleEvents() calls the host system to emit a 
+	 *  host-provided expose event for the damaged area which is then
+	 *  interpreted in the @c translatePuglEvent() method where it calls 
+	 *  drawing of all linked child widget RGBA surfaces to the host provided
+	 *  RGBA surface.
 	 */
 	virtual void onExposeRequest (BEvents::Event* event) override;
 
@@ -210,6 +243,23 @@ public:
 	 */
 	void purgeEventQueue (Widget* widget = nullptr);
 
+	/**
+	 *  @brief  Registers a linked Pollable widget to be polled once per 
+	 *  frame.
+	 *  @param widget  Widget. Ignored if not Pollable.
+	 *
+	 *  Called by Widget upon linking. Only registered widgets are polled.
+	 */
+	void addPollable (Widget* widget);
+
+	/**
+	 *  @brief  Unregisters a Pollable widget.
+	 *  @param widget  Widget.
+	 *
+	 *  Called by Widget upon release (and thus upon destruction).
+	 */
+	void removePollable (Widget* widget);
+
 	/**
 	 *  @brief  Checks if close of the main %Window is scheduled.
 	 *  @return  True, if quit is scheduled, otherwise false.
@@ -236,6 +286,9 @@ protected:
 	static PuglStatus translatePuglEvent (PuglView* view, const PuglEvent* event);
 
 	void translateTimeEvent ();
+	void translatePolls ();
+	bool isFrameDue () const;
+	void postDamage ();
 
 	void unfocus();
 };
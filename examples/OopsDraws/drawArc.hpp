@@ -35,21 +35,17 @@
 #endif
 
 /**
- *  @brief  Draws a pseudo 3d arc in a Cairo context. 
+ *  @brief  Draws the static (value-independent) elements of a pseudo 3d arc
+ *  in a Cairo context. 
  *  @param cr  Cairo context.
  *  @param xc  X center position.
  *  @param y0  Y center position.
  *  @param radius  Arc radius.
- *  @param min  Start of activated (highlighted) part of the arc. Relative
- *  value [0..1].
- *  @param max  End of activated (highlighted) part of the arc. Relative
- *  value [0..1].
  *  @param fgColor  RGBA color for the activated part.
  *  @param bgColor  Bar RGBA color.
  */
-inline void drawArc     (cairo_t* cr, const double xc, const double yc, const double radius,
-                         const double min, const double max, 
-                         const BStyles::Color fgColor, const BStyles::Color bgColor)
+inline void drawArcStatic   (cairo_t* cr, const double xc, const double yc, const double radius,
+                             const BStyles::Color fgColor, const BStyles::Color bgColor)
 {
     cairo_set_line_width (cr, 0.0);
     
@@ -65,12 +61,55 @@ inline void drawArc     (cairo_t* cr, const double xc, const double yc, const do
     cairo_arc (cr, xc, yc, 0.1 * radius, 0, 2 * M_PI);
     cairo_close_path (cr);
     cairo_fill (cr);
+}
+
+/**
+ *  @brief  Draws the active (value-dependent) elements of a pseudo 3d arc 
+ *  in a Cairo context. 
+ *  @param cr  Cairo context.
+ *  @param xc  X center position.
+ *  @param y0  Y center position.
+ *  @param radius  Arc radius.
+ *  @param min  Start of activated (highlighted) part of the arc. Relative
+ *  value [0..1].
+ *  @param max  End of activated (highlighted) part of the arc. Relative
+ *  value [0..1].
+ *  @param fgColor  RGBA color for the activated part.
+ *  @param bgColor  Bar RGBA color.
+ */
+inline void drawArcActive   (cairo_t* cr, const double xc, const double yc, const double radius,
+                             const double min, const double max, 
+                             const BStyles::Color fgColor, const BStyles::Color bgColor)
+{
+    cairo_set_line_width (cr, 0.0);
 
     // Fill
+    cairo_set_source_rgba (cr, CAIRO_RGBA(fgColor));
     cairo_arc (cr, xc, yc,  0.96 * radius - 0.2, BWIDGETS_DEFAULT_DRAWARC_START + min * BWIDGETS_DEFAULT_DRAWARC_SIZE, BWIDGETS_DEFAULT_DRAWARC_START + max * BWIDGETS_DEFAULT_DRAWARC_SIZE);
     cairo_arc_negative (cr, xc, yc,  0.7 * radius - 0.2, BWIDGETS_DEFAULT_DRAWARC_START + max * BWIDGETS_DEFAULT_DRAWARC_SIZE, BWIDGETS_DEFAULT_DRAWARC_START + min * BWIDGETS_DEFAULT_DRAWARC_SIZE);
     cairo_close_path (cr);
     cairo_fill (cr);
 }
 
+/**
+ *  @brief  Draws a pseudo 3d arc in a Cairo context. 
+ *  @param cr  Cairo context.
+ *  @param xc  X center position.
+ *  @param y0  Y center position.
+ *  @param radius  Arc radius.
+ *  @param min  Start of activated (highlighted) part of the arc. Relative
+ *  value [0..1].
+ *  @param max  End of activated (highlighted) part of the arc. Relative
+ *  value [0..1].
+ *  @param fgColor  RGBA color for the activated part.
+ *  @param bgColor  Bar RGBA color.
+ */
+inline void drawArc     (cairo_t* cr, const double xc, const double yc, const double radius,
+                         const double min, const double max, 
+                         const BStyles::Color fgColor, const BStyles::Color bgColor)
+{
+    drawArcStatic (cr, xc, yc, radius, fgColor, bgColor);
+    drawArcActive (cr, xc, yc, radius, min, max, fgColor, bgColor);
+}
+
 #endif /*  BWIDGETS_DRAWARC_HPP_ */
\ No newline at end of file